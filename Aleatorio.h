@@ -0,0 +1,96 @@
+#ifndef ALEATORIO_H
+#define ALEATORIO_H
+
+#include <cstdint>
+#include <limits>
+
+using namespace std;
+
+// Generador xoshiro256** (Blackman y Vigna): 32 bytes de estado, sin llamadas al sistema al sembrarlo.
+// Cumple UniformRandomBitGenerator, asi que sirve con las distribuciones de <random>
+class GeneradorAleatorio {
+   public:
+    typedef uint64_t result_type;
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return numeric_limits<result_type>::max(); }
+
+    explicit GeneradorAleatorio(uint64_t semilla = 0) {
+        sembrar(semilla, 0);
+    }
+
+    // Flujo independiente numero 'flujo' derivado de la misma semilla (uno por hilo, pareja o isla)
+    GeneradorAleatorio(uint64_t semilla, uint64_t flujo) {
+        sembrar(semilla, flujo);
+    }
+
+    void sembrar(uint64_t semilla, uint64_t flujo) {
+        // splitmix64 sobre la semilla mezclada con el flujo para llenar el estado
+        uint64_t x = semilla ^ (flujo * 0xD1B54A32D192ED03ULL);
+        for (int i = 0; i < 4; ++i) {
+            estado[i] = splitmix64(x);
+        }
+    }
+
+    result_type operator()() {
+        const uint64_t resultado = rotar(estado[1] * 5, 7) * 9;
+        const uint64_t t = estado[1] << 17;
+
+        estado[2] ^= estado[0];
+        estado[3] ^= estado[1];
+        estado[1] ^= estado[2];
+        estado[0] ^= estado[3];
+        estado[2] ^= t;
+        estado[3] = rotar(estado[3], 45);
+
+        return resultado;
+    }
+
+    // Numero real uniforme en [0, 1) con 53 bits de precision
+    double uniforme() {
+        return ((*this)() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    // Entero uniforme en [0, n) por multiplicacion (Lemire), sin division
+    uint32_t enteroMenorQue(uint32_t n) {
+        return static_cast<uint32_t>(((*this)() >> 32) * n >> 32);
+    }
+
+    // Avanzar 2^128 pasos: produce un flujo que no se solapa con el actual
+    void saltar() {
+        static const uint64_t SALTO[] = {0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+                                         0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL};
+        uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+        for (int i = 0; i < 4; ++i) {
+            for (int b = 0; b < 64; ++b) {
+                if (SALTO[i] & (1ULL << b)) {
+                    s0 ^= estado[0];
+                    s1 ^= estado[1];
+                    s2 ^= estado[2];
+                    s3 ^= estado[3];
+                }
+                (*this)();
+            }
+        }
+        estado[0] = s0;
+        estado[1] = s1;
+        estado[2] = s2;
+        estado[3] = s3;
+    }
+
+    uint64_t estado[4];  // Estado completo, expuesto para poder guardarlo y restaurarlo
+
+   private:
+    static uint64_t rotar(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    static uint64_t splitmix64(uint64_t& x) {
+        uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+};
+
+#endif /* ALEATORIO_H */
@@ -0,0 +1,286 @@
+#ifndef ARCHIVOESCENARIOS_H
+#define ARCHIVOESCENARIOS_H
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+#include "Escenario.h"
+#include "Serializacion.h"
+
+// Forma binaria de una lista de escenarios, pensada para proyectarse en memoria y leerse sin interpretar texto.
+// Todos los campos estan alineados a 8 bytes y en el orden de bytes del equipo:
+//
+//   cabecera:   char[8] "GAESCEN1", uint32 version, uint32 numero de escenarios
+//   indice:     por escenario, uint64 desplazamiento y uint64 longitud de su registro
+//   registro:   uint32 longitud del nombre, nombre (relleno a 8)
+//               int32 cultivos, meses, poblacion, generaciones; uint64 semilla; uint32 semillaDada, relleno
+//               double areaTotalDisponible, conductividadElectrica
+//               int32 mesesCultivo[C] (relleno a 8), double requerimientoAgua[C], aguaInicialDisponible[M],
+//               int32 cultivable[C * M] (relleno a 8), double reduccionRendimiento[C], salinidadCritica[C],
+//               maxCosechaPorArea[C], cambioSalinidadPorArea[C], susceptibilidadAgua[C]
+//
+// Las longitudes de las tablas se deducen de C y M, asi que el registro no repite tamanos
+class ArchivoEscenarios {
+   public:
+    static const uint32_t VERSION = 1;
+
+    ArchivoEscenarios() : datos(nullptr), bytes(0), proyectado(false) {}
+
+    ~ArchivoEscenarios() { cerrar(); }
+
+    ArchivoEscenarios(const ArchivoEscenarios&) = delete;
+    ArchivoEscenarios& operator=(const ArchivoEscenarios&) = delete;
+
+    // Si el archivo empieza con la marca del formato binario
+    static bool esBinario(const char* ruta) {
+        char leida[LONGITUD_MARCA] = {0};
+        ifstream entrada(ruta, ios::binary);
+        return entrada.read(leida, LONGITUD_MARCA) && memcmp(leida, marca(), LONGITUD_MARCA) == 0;
+    }
+
+    // Proyectar el archivo en memoria y comprobar su indice; los escenarios se copian despues, uno a uno
+    bool abrir(const char* ruta, string& error) {
+        cerrar();
+        if (!proyectar(ruta)) {
+            error = string("no se pudo leer ") + ruta;
+            return false;
+        }
+        const char* cursor = datos + LONGITUD_MARCA;
+        const char* fin = datos + bytes;
+        uint32_t version = 0, numero = 0;
+        if (bytes < LONGITUD_MARCA || memcmp(datos, marca(), LONGITUD_MARCA) != 0 || !leerValor(cursor, fin, version) ||
+            !leerValor(cursor, fin, numero) || version != VERSION || static_cast<size_t>(fin - cursor) / 16 < numero) {
+            error = string(ruta) + " no es un archivo de escenarios version " + to_string(VERSION);
+            cerrar();
+            return false;
+        }
+        registros.resize(numero);
+        for (uint32_t i = 0; i < numero; ++i) {
+            uint64_t desplazamiento = 0, longitud = 0;
+            leerValor(cursor, fin, desplazamiento);
+            leerValor(cursor, fin, longitud);
+            Registro& r = registros[i];
+            // Los punteros se forman solo despues de comprobar que el registro cae dentro del archivo
+            bool dentro = desplazamiento % 8 == 0 && desplazamiento <= bytes && longitud <= bytes - desplazamiento;
+            if (dentro) {
+                r.inicio = datos + desplazamiento;
+                r.fin = r.inicio + longitud;
+            }
+            if (!dentro || !leerDimensiones(r)) {
+                error = string(ruta) + ": el registro del escenario " + to_string(i) + " esta danado";
+                cerrar();
+                return false;
+            }
+            // Los mismos valores que Escenario::validar rechaza en la lista de texto, con el mismo mensaje
+            string motivo;
+            if (!valoresPositivos(reinterpret_cast<const int*>(r.tablas), r.numeroCultivos, r.areaTotalDisponible, motivo)) {
+                error = string(ruta) + ": escenario " + nombre(r) + ": " + motivo;
+                cerrar();
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void cerrar() {
+#ifndef _WIN32
+        if (proyectado) munmap(const_cast<char*>(datos), bytes);
+#endif
+        datos = nullptr;
+        bytes = 0;
+        proyectado = false;
+        copia.clear();
+        registros.clear();
+    }
+
+    int size() const { return static_cast<int>(registros.size()); }
+
+    // Trabajo aproximado del escenario i, sin copiar sus tablas
+    double costo(int i) const {
+        const Registro& r = registros[i];
+        return static_cast<double>(r.tamanoPoblacion) * r.maximoGeneraciones * r.numeroCultivos * r.meses;
+    }
+
+    // Copiar el escenario i en 'escenario'; las tablas reutilizan la capacidad que ya tengan sus vectores
+    void cargar(int i, Escenario& escenario) const {
+        const Registro& r = registros[i];
+        escenario.nombre = nombre(r);
+        const char* cursor = r.tablas;
+
+        size_t C = r.numeroCultivos, M = r.meses;
+        escenario.numeroCultivos = r.numeroCultivos;
+        escenario.meses = r.meses;
+        escenario.tamanoPoblacion = r.tamanoPoblacion;
+        escenario.maximoGeneraciones = r.maximoGeneraciones;
+        escenario.semilla = r.semilla;
+        escenario.semillaDada = r.semillaDada;
+        Cultivacion& c = escenario.cultivacion;
+        c.areaTotalDisponible = r.areaTotalDisponible;
+        c.conductividadElectrica = r.conductividadElectrica;
+        copiarTabla(cursor, C, c.mesesCultivo);
+        copiarTabla(cursor, C, c.requerimientoAgua);
+        copiarTabla(cursor, M, c.aguaInicialDisponible);
+        copiarTabla(cursor, C * M, c.cultivable);
+        copiarTabla(cursor, C, c.reduccionRendimiento);
+        copiarTabla(cursor, C, c.salinidadCritica);
+        copiarTabla(cursor, C, c.maxCosechaPorArea);
+        copiarTabla(cursor, C, c.cambioSalinidadPorArea);
+        copiarTabla(cursor, C, c.susceptibilidadAgua);
+    }
+
+    // Escribir escenarios ya validados en el formato binario
+    static bool escribir(const char* ruta, const vector<Escenario>& escenarios, string& error) {
+        vector<char> buffer(marca(), marca() + LONGITUD_MARCA);
+        escribirValor(buffer, static_cast<uint32_t>(VERSION));
+        escribirValor(buffer, static_cast<uint32_t>(escenarios.size()));
+        size_t indice = buffer.size();
+        buffer.resize(indice + 16 * escenarios.size());
+
+        for (size_t i = 0; i < escenarios.size(); ++i) {
+            const Escenario& e = escenarios[i];
+            const Cultivacion& c = e.cultivacion;
+            uint64_t desplazamiento = buffer.size();
+            escribirValor(buffer, static_cast<uint32_t>(e.nombre.size()));
+            buffer.insert(buffer.end(), e.nombre.begin(), e.nombre.end());
+            rellenar(buffer);
+            escribirValor(buffer, static_cast<int32_t>(e.numeroCultivos));
+            escribirValor(buffer, static_cast<int32_t>(e.meses));
+            escribirValor(buffer, static_cast<int32_t>(e.tamanoPoblacion));
+            escribirValor(buffer, static_cast<int32_t>(e.maximoGeneraciones));
+            escribirValor(buffer, e.semilla);
+            escribirValor(buffer, static_cast<uint32_t>(e.semillaDada));
+            escribirValor(buffer, static_cast<uint32_t>(0));
+            escribirValor(buffer, c.areaTotalDisponible);
+            escribirValor(buffer, c.conductividadElectrica);
+            escribirTabla(buffer, c.mesesCultivo);
+            escribirTabla(buffer, c.requerimientoAgua);
+            escribirTabla(buffer, c.aguaInicialDisponible);
+            escribirTabla(buffer, c.cultivable);
+            escribirTabla(buffer, c.reduccionRendimiento);
+            escribirTabla(buffer, c.salinidadCritica);
+            escribirTabla(buffer, c.maxCosechaPorArea);
+            escribirTabla(buffer, c.cambioSalinidadPorArea);
+            escribirTabla(buffer, c.susceptibilidadAgua);
+
+            uint64_t longitud = buffer.size() - desplazamiento;
+            memcpy(&buffer[indice + 16 * i], &desplazamiento, sizeof(desplazamiento));
+            memcpy(&buffer[indice + 16 * i + 8], &longitud, sizeof(longitud));
+        }
+
+        ofstream salida(ruta, ios::binary);
+        if (!salida.write(buffer.data(), buffer.size())) {
+            error = string("no se pudo escribir ") + ruta;
+            return false;
+        }
+        return true;
+    }
+
+   private:
+    static const int LONGITUD_MARCA = 8;
+
+    static const char* marca() { return "GAESCEN1"; }
+
+    // Campos fijos de un registro, leidos al abrir para poder repartir los escenarios sin copiarlos
+    struct Registro {
+        const char* inicio;
+        const char* fin;
+        const char* tablas;  // Primera tabla (mesesCultivo)
+        int32_t numeroCultivos, meses, tamanoPoblacion, maximoGeneraciones;
+        uint64_t semilla;
+        uint32_t semillaDada;
+        double areaTotalDisponible, conductividadElectrica;
+    };
+
+    const char* datos;         // Contenido del archivo, proyectado o copiado
+    size_t bytes;
+    bool proyectado;           // Si 'datos' viene de mmap (si no, apunta a 'copia')
+    vector<char> copia;        // Contenido leido por completo donde no hay mmap
+    vector<Registro> registros;
+
+    bool proyectar(const char* ruta) {
+#ifndef _WIN32
+        int descriptor = open(ruta, O_RDONLY);
+        if (descriptor < 0) return false;
+        struct stat informacion;
+        bool correcto = fstat(descriptor, &informacion) == 0 && informacion.st_size > 0;
+        if (correcto) {
+            void* mapa = mmap(nullptr, informacion.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+            correcto = mapa != MAP_FAILED;
+            if (correcto) {
+                datos = static_cast<const char*>(mapa);
+                bytes = informacion.st_size;
+                proyectado = true;
+            }
+        }
+        close(descriptor);
+        return correcto;
+#else
+        ifstream entrada(ruta, ios::binary);
+        copia.assign(istreambuf_iterator<char>(entrada), istreambuf_iterator<char>());
+        datos = copia.data();
+        bytes = copia.size();
+        return entrada.good() || entrada.eof();
+#endif
+    }
+
+    static size_t relleno(size_t bytes) { return (8 - bytes % 8) % 8; }
+
+    // Nombre de un registro ya comprobado por leerDimensiones
+    static string nombre(const Registro& r) {
+        const char* cursor = r.inicio;
+        uint32_t longitudNombre = 0;
+        leerValor(cursor, r.fin, longitudNombre);
+        return string(cursor, longitudNombre);
+    }
+
+    static void rellenar(vector<char>& buffer) { buffer.resize(buffer.size() + relleno(buffer.size())); }
+
+    template <class T>
+    static void escribirTabla(vector<char>& buffer, const vector<T>& tabla) {
+        const char* inicio = reinterpret_cast<const char*>(tabla.data());
+        buffer.insert(buffer.end(), inicio, inicio + tabla.size() * sizeof(T));
+        rellenar(buffer);
+    }
+
+    template <class T>
+    static void copiarTabla(const char*& cursor, size_t cantidad, vector<T>& tabla) {
+        const T* inicio = reinterpret_cast<const T*>(cursor);
+        tabla.assign(inicio, inicio + cantidad);
+        cursor += cantidad * sizeof(T) + relleno(cantidad * sizeof(T));
+    }
+
+    // Leer los campos fijos y comprobar que las tablas caben en el registro
+    static bool leerDimensiones(Registro& r) {
+        const char* cursor = r.inicio;
+        uint32_t longitudNombre = 0, sinUso = 0;
+        if (!leerValor(cursor, r.fin, longitudNombre) || static_cast<size_t>(r.fin - cursor) < longitudNombre) return false;
+        cursor += longitudNombre + relleno(sizeof(uint32_t) + longitudNombre);
+        if (cursor > r.fin || !leerValor(cursor, r.fin, r.numeroCultivos) || !leerValor(cursor, r.fin, r.meses) ||
+            !leerValor(cursor, r.fin, r.tamanoPoblacion) || !leerValor(cursor, r.fin, r.maximoGeneraciones) ||
+            !leerValor(cursor, r.fin, r.semilla) || !leerValor(cursor, r.fin, r.semillaDada) || !leerValor(cursor, r.fin, sinUso) ||
+            !leerValor(cursor, r.fin, r.areaTotalDisponible) || !leerValor(cursor, r.fin, r.conductividadElectrica)) {
+            return false;
+        }
+        // Los mismos limites que Escenario::validar aplica a la lista de texto
+        if (r.numeroCultivos <= 0 || r.meses <= 0 || r.tamanoPoblacion < 2 || r.maximoGeneraciones < 0) return false;
+        r.tablas = cursor;
+        size_t C = r.numeroCultivos, M = r.meses;
+        size_t enteros = 4 * C + relleno(4 * C) + 4 * C * M + relleno(4 * C * M);
+        size_t dobles = 8 * (6 * C + M);
+        return static_cast<size_t>(r.fin - cursor) >= enteros + dobles;
+    }
+};
+
+#endif /* ARCHIVOESCENARIOS_H */
@@ -0,0 +1,95 @@
+#ifndef ARENATRABAJO_H
+#define ARENATRABAJO_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+#include "VistaCromosoma.h"
+
+// Memoria de trabajo de un hilo para los arreglos temporales de los operadores (area y agua disponibles,
+// orden de los cultivos, limites de agua). Cada pedido solo avanza un desplazamiento dentro de un bloque y
+// reiniciar() lo devuelve al principio, asi que una vez que el bloque alcanza para un hijo completo ningun
+// operador vuelve a pedir memoria al heap. Solo para tipos triviales: no se llaman constructores ni destructores
+class ArenaTrabajo {
+   public:
+    uint64_t crecimientos = 0;  // Bloques pedidos al heap desde que se creo la arena
+
+    // Arreglo de 'cantidad' elementos sin inicializar, valido hasta el siguiente reiniciar()
+    template <class T>
+    Fila<T> reservar(size_t cantidad) {
+        size_t bytes = cantidad * sizeof(T);
+        size_t inicio = (usado + alignof(T) - 1) / alignof(T) * alignof(T);
+        if (bloques.empty() || inicio + bytes > bloques.back().size()) {
+            crecer(bytes);
+            inicio = 0;
+        }
+        usado = inicio + bytes;
+        return Fila<T>(reinterpret_cast<T*>(bloques.back().data() + inicio), cantidad);
+    }
+
+    // Arreglo de 'cantidad' elementos iguales a 'valor'
+    template <class T>
+    Fila<T> reservar(size_t cantidad, T valor) {
+        Fila<T> arreglo = reservar<T>(cantidad);
+        fill(arreglo.begin(), arreglo.end(), valor);
+        return arreglo;
+    }
+
+    // Copia de un vector
+    template <class T>
+    Fila<T> copiar(const vector<T>& origen) {
+        Fila<T> arreglo = reservar<T>(origen.size());
+        copy(origen.begin(), origen.end(), arreglo.begin());
+        return arreglo;
+    }
+
+    // Dar por libre todo lo reservado. Si la ronda anterior no cupo en un bloque, los bloques se juntan en uno
+    // del tamano total para que la siguiente quepa sin crecer
+    void reiniciar() {
+        if (bloques.size() > 1) {
+            size_t total = 0;
+            for (const vector<char>& bloque : bloques) total += bloque.size();
+            bloques.clear();
+            bloques.emplace_back(total);
+            ++crecimientos;
+        }
+        usado = 0;
+    }
+
+    // Dejar un solo bloque de al menos 'bytes'; lo reservado antes deja de ser valido
+    void asegurarCapacidad(size_t bytes) {
+        if (capacidad() >= bytes) return;
+        bloques.clear();
+        bloques.emplace_back(bytes);
+        usado = 0;
+        ++crecimientos;
+    }
+
+    size_t capacidad() const {
+        size_t total = 0;
+        for (const vector<char>& bloque : bloques) total += bloque.size();
+        return total;
+    }
+
+   private:
+    static const size_t BLOQUE_MINIMO = 4096;
+
+    // La memoria de operator new esta alineada para cualquier tipo fundamental, asi que basta con alinear el
+    // desplazamiento dentro del bloque
+    vector<vector<char> > bloques;
+    size_t usado = 0;  // Bytes ocupados del ultimo bloque
+
+    // Nuevo bloque al final; los anteriores no se mueven, asi que lo ya reservado sigue siendo valido
+    void crecer(size_t bytes) {
+        size_t tamano = bloques.empty() ? bytes : max(bytes, 2 * bloques.back().size());
+        if (tamano < BLOQUE_MINIMO) tamano = BLOQUE_MINIMO;
+        bloques.emplace_back(tamano);
+        ++crecimientos;
+    }
+};
+
+#endif /* ARENATRABAJO_H */
@@ -0,0 +1,126 @@
+#ifndef CACHEAPTITUD_H
+#define CACHEAPTITUD_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+using namespace std;
+
+// Huella de 128 bits del contenido de un cromosoma; dos mezclas independientes hacen despreciable una colision
+struct HuellaCromosoma {
+    uint64_t clave;         // Elige el conjunto de la tabla
+    uint64_t verificacion;  // Confirma que la entrada es del mismo cromosoma
+};
+
+// Huella de los genes de una fila, partiendo de 'base' (que distingue el escenario y las dimensiones)
+template <class T>
+inline HuellaCromosoma calcularHuella(const T* genes, int dimension, uint64_t base) {
+    const uint64_t K1 = 0x9E3779B97F4A7C15ULL, K2 = 0xC2B2AE3D27D4EB4FULL;
+    uint64_t a = base ^ (static_cast<uint64_t>(dimension) * K1);
+    uint64_t b = ~base + static_cast<uint64_t>(dimension) * K2;
+    for (int i = 0; i < dimension; ++i) {
+        uint64_t bits = 0;
+        memcpy(&bits, genes + i, sizeof(T));
+        a = (a ^ bits) * K1;
+        a ^= a >> 29;
+        b = (b + bits) * K2;
+        b ^= b >> 31;
+    }
+    HuellaCromosoma huella;
+    huella.clave = a ^ (a >> 32);
+    huella.verificacion = (b ^ (b >> 33)) | 1;  // Nunca cero: cero marca una entrada vacia
+    return huella;
+}
+
+// Cache acotada de valores objetivo indexada por el contenido de los genes. Asociativa por conjuntos de
+// VIAS entradas; cada grupo de conjuntos tiene su propio candado para que varios hilos consulten a la vez
+class CacheAptitud {
+   public:
+    static const int VIAS = 4;
+    static const int CANDADOS = 64;
+
+    atomic<uint64_t> aciertos;  // Consultas resueltas sin evaluar
+    atomic<uint64_t> fallos;    // Consultas que requirieron evaluar la funcion objetivo
+
+    // La capacidad se redondea a una potencia de 2 de entradas (0 desactiva la cache)
+    explicit CacheAptitud(int capacidad = 1 << 16) : aciertos(0), fallos(0), mascaraConjuntos(0) {
+        redimensionar(capacidad);
+    }
+
+    CacheAptitud(const CacheAptitud&) = delete;
+    CacheAptitud& operator=(const CacheAptitud&) = delete;
+
+    void redimensionar(int capacidad) {
+        int conjuntos = 0;
+        if (capacidad >= VIAS) {
+            conjuntos = 1;
+            while (conjuntos * 2 * VIAS <= capacidad) conjuntos *= 2;
+        }
+        entradas.assign(static_cast<size_t>(conjuntos) * VIAS, Entrada());
+        mascaraConjuntos = conjuntos > 0 ? conjuntos - 1 : 0;
+        reiniciarContadores();
+    }
+
+    int capacidad() const { return static_cast<int>(entradas.size()); }
+
+    void limpiar() {
+        entradas.assign(entradas.size(), Entrada());
+    }
+
+    void reiniciarContadores() {
+        aciertos.store(0);
+        fallos.store(0);
+    }
+
+    // Buscar el valor guardado para la huella; cuenta el acierto o el fallo
+    bool buscar(const HuellaCromosoma& huella, double& valor) {
+        if (!entradas.empty()) {
+            size_t conjunto = huella.clave & mascaraConjuntos;
+            lock_guard<mutex> bloqueo(candados[conjunto % CANDADOS]);
+            const Entrada* via = &entradas[conjunto * VIAS];
+            for (int v = 0; v < VIAS; ++v) {
+                if (via[v].verificacion == huella.verificacion && via[v].clave == huella.clave) {
+                    valor = via[v].valor;
+                    aciertos.fetch_add(1, memory_order_relaxed);
+                    return true;
+                }
+            }
+        }
+        fallos.fetch_add(1, memory_order_relaxed);
+        return false;
+    }
+
+    // Guardar un valor; si el conjunto esta lleno se reemplaza la via elegida por la propia huella
+    void guardar(const HuellaCromosoma& huella, double valor) {
+        if (entradas.empty()) return;
+        size_t conjunto = huella.clave & mascaraConjuntos;
+        lock_guard<mutex> bloqueo(candados[conjunto % CANDADOS]);
+        Entrada* via = &entradas[conjunto * VIAS];
+        int elegida = static_cast<int>(huella.verificacion >> 62);
+        for (int v = 0; v < VIAS; ++v) {
+            if (via[v].verificacion == 0 || (via[v].verificacion == huella.verificacion && via[v].clave == huella.clave)) {
+                elegida = v;
+                break;
+            }
+        }
+        via[elegida].clave = huella.clave;
+        via[elegida].verificacion = huella.verificacion;
+        via[elegida].valor = valor;
+    }
+
+   private:
+    struct Entrada {
+        uint64_t clave = 0;
+        uint64_t verificacion = 0;
+        double valor = 0.0;
+    };
+
+    vector<Entrada> entradas;
+    size_t mascaraConjuntos;
+    mutex candados[CANDADOS];
+};
+
+#endif /* CACHEAPTITUD_H */
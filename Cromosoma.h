@@ -13,10 +13,16 @@
 
 using namespace std;
 
+#include "Aleatorio.h"
+#include "ArenaTrabajo.h"
+#include "Cultivacion.h"
+#include "Instrumentacion.h"
+#include "VistaCromosoma.h"
+
 class Cromosoma {
    public:
-    vector<double> genes;            // Representa el cromosoma
-    vector<double> cultivoPlantado;  // Arreglo de cultivoPlantado para el cromosoma
+    vector<TipoGen> genes;            // Representa el cromosoma
+    vector<TipoGen> cultivoPlantado;  // Arreglo de cultivoPlantado para el cromosoma
     double valorObjetivo;            // Almacena el valor de la funcion objetivo
 
     Cromosoma() : genes(0), cultivoPlantado(0), valorObjetivo(0.0) {}
@@ -24,29 +30,33 @@ class Cromosoma {
     Cromosoma(int dimension)
         : genes(dimension, 0.0), cultivoPlantado(dimension, 0.0), valorObjetivo(0.0) {}
 
-    // Validar si el cultivo puede crecer en los meses actuales y subsiguientes
-    static bool esCultivable(const vector<int>& cultivable, int cultivo, int mes, int periodoCrecimiento, int numeroCultivos) {
-        for (int m = 0; m < periodoCrecimiento && (mes + m) < cultivable.size() / numeroCultivos; ++m) {
-            if (cultivable[(cultivo) + numeroCultivos * (mes + m)] == 0) {
-                return false;  // El cultivo no puede ser cultivado en este mes
-            }
-        }
-        return true;  // El cultivo puede ser cultivado en todos los meses requeridos
+    // Vista sobre los genes de este cromosoma, para usarlo con los operadores de Generacion
+    VistaCromosoma vista() {
+        return VistaCromosoma(Fila<TipoGen>(genes.data(), genes.size()), Fila<TipoGen>(cultivoPlantado.data(), cultivoPlantado.size()));
+    }
+
+    VistaConstCromosoma vista() const {
+        return VistaConstCromosoma(Fila<const TipoGen>(genes.data(), genes.size()), Fila<const TipoGen>(cultivoPlantado.data(), cultivoPlantado.size()));
     }
 
     // Calcular si se debe entrar al bucle de inicializacion basado en la condicion exponencial
-    static bool debeEntrarAlBucleDeInicializacion(double areaDisponible) {
+    static bool debeEntrarAlBucleDeInicializacion(double areaDisponible, GeneradorAleatorio& gen) {
         double resultado = -0.7 * exp(-6 * areaDisponible + 5.25) + 107;
-        return resultado > (rand() % 100);
+        return resultado > gen.enteroMenorQue(100);
+    }
+
+    // Probabilidad exacta de que debeEntrarAlBucleDeInicializacion devuelva true: la fraccion de los enteros
+    // 0..99 menores que la condicion exponencial
+    static double probabilidadDeEntrarAlBucle(double areaDisponible) {
+        double resultado = -0.7 * exp(-6 * areaDisponible + 5.25) + 107;
+        return min(100.0, max(0.0, ceil(resultado))) / 100.0;
     }
 
     // Validar si el agua disponible es suficiente para el crecimiento del cultivo durante el periodo de crecimiento con una probabilidad de continuar basada en la escasez
-    static bool esAguaSuficiente(const vector<double>& aguaDisponible, const vector<double>& requerimientoAgua, int cultivo, int mes, int periodoCrecimiento, double areaUsada, double areaTotalDisponible) {
+    static bool esAguaSuficiente(Fila<const double> aguaDisponible, const vector<double>& requerimientoAgua, int cultivo, int mes, int periodoCrecimiento, double areaUsada, double areaTotalDisponible, GeneradorAleatorio& gen) {
         double areaEnHectareas = areaUsada * areaTotalDisponible;  // Convertir porcentaje de area usada a hectareas
-        random_device rd;
-        mt19937 gen(rd());
 
-        for (int m = 0; m < periodoCrecimiento && (mes + m) < aguaDisponible.size(); ++m) {
+        for (int m = 0; m < periodoCrecimiento && (mes + m) < static_cast<int>(aguaDisponible.size()); ++m) {
             double aguaRequerida = requerimientoAgua[cultivo] * areaEnHectareas;  // Agua requerida para este cultivo en el area en hectareas
             double disponible = aguaDisponible[mes + m];
 
@@ -55,8 +65,7 @@ class Cromosoma {
                 double probabilidadContinuar = 1.0 - porcentajeEscasez;                   // Probabilidad de continuar el bucle
 
                 // Verificar si debemos continuar basado en la probabilidad calculada
-                uniform_real_distribution<> dis(0.0, 1.0);
-                if (dis(gen) > probabilidadContinuar) {
+                if (gen.uniforme() > probabilidadContinuar) {
                     return false;  // No hay suficiente agua y la probabilidad de continuar fallo
                 }
             }
@@ -64,27 +73,53 @@ class Cromosoma {
         return true;  // Suficiente agua para todo el periodo de crecimiento o continuado basado en la probabilidad
     }
 
-    // Metodo estatico para inicializar una luciernaga y devolverla
-    static Cromosoma inicializar(int dimension, int numeroCultivos, int meses, const vector<int>& mesesCultivo,
-                                 const vector<double>& requerimientoAgua, const vector<int>& cultivable,
-                                 const vector<double>& aguaInicialDisponible, double areaTotalDisponible) {
-        Cromosoma nuevoCromosoma(dimension);                    // Crear un nuevo objeto Cromosoma
-        vector<double> areaDisponible(meses, 1.0);              // Inicializar area disponible al 100% para cada mes
-        vector<double> aguaDisponible = aguaInicialDisponible;  // Copiar disponibilidad inicial de agua
+    // Asignar area a los arreglos genes y cultivoPlantado para los meses actuales y subsiguientes, descontando
+    // el area y el agua que usa la siembra
+    static void sembrar(VistaCromosoma nuevoCromosoma, int numeroCultivos, int meses, int cultivo, int mes, int periodoCrecimiento,
+                        double areaUsada, const vector<double>& requerimientoAgua, double areaTotalDisponible,
+                        Fila<double> areaDisponible, Fila<double> aguaDisponible) {
+        for (int m = 0; m < periodoCrecimiento && (mes + m) < meses; ++m) {
+            int indice = cultivo + numeroCultivos * (mes + m);
+            nuevoCromosoma.genes[indice] += areaUsada;
+            areaDisponible[mes + m] -= areaUsada;
+
+            double areaEnHectareas = areaUsada * areaTotalDisponible;
+            double aguaADeducir = requerimientoAgua[cultivo] * areaEnHectareas;
+
+            if (aguaDisponible[mes + m] < aguaADeducir) {
+                aguaADeducir = aguaDisponible[mes + m];
+            }
+            aguaDisponible[mes + m] -= aguaADeducir;
+        }
+
+        // Actualizar el arreglo cultivoPlantado
+        int indicePlantacion = cultivo + numeroCultivos * mes;
+        nuevoCromosoma.cultivoPlantado[indicePlantacion] = areaUsada;
+    }
+
+    // Metodo estatico para inicializar una luciernaga directamente sobre la fila de destino. Los arreglos de
+    // trabajo salen de 'arena', que el llamador reinicia
+    static void inicializar(VistaCromosoma nuevoCromosoma, int numeroCultivos, int meses, const vector<int>& mesesCultivo,
+                            const vector<double>& requerimientoAgua, const IndiceFactibilidad& factibilidad,
+                            const vector<double>& aguaInicialDisponible, double areaTotalDisponible,
+                            ArenaTrabajo& arena, GeneradorAleatorio& gen) {
+        nuevoCromosoma.limpiar();                                       // Partir de un cromosoma vacio
+        Fila<double> areaDisponible = arena.reservar(meses, 1.0);       // Inicializar area disponible al 100% para cada mes
+        Fila<double> aguaDisponible = arena.copiar(aguaInicialDisponible);  // Copiar disponibilidad inicial de agua
 
-        random_device rd;
-        mt19937 gen(rd());
         chi_squared_distribution<> dist(5);
 
         // Inicializar los arreglos genes y cultivoPlantado
         for (int mes = 0; mes < meses; ++mes) {
-            while (debeEntrarAlBucleDeInicializacion(areaDisponible[mes])) {
+            // Si ningun cultivo puede sembrarse este mes el bucle solo rechazaria (y sin fin si el area esta libre)
+            while (factibilidad.cultivosEnMes(mes) > 0 && debeEntrarAlBucleDeInicializacion(areaDisponible[mes], gen)) {
                 // Seleccionar un cultivo aleatorio
-                int cultivo = rand() % numeroCultivos;
+                int cultivo = gen.enteroMenorQue(numeroCultivos);
                 int periodoCrecimiento = mesesCultivo[cultivo];
 
                 // Validar si el cultivo puede ser cultivado
-                if (!esCultivable(cultivable, cultivo, mes, periodoCrecimiento, numeroCultivos)) {
+                if (!factibilidad.puedeSembrar(cultivo, mes)) {
+                    GA_CONTAR(RECHAZO_INICIALIZAR_CULTIVABLE);
                     continue;
                 }
 
@@ -93,28 +128,13 @@ class Cromosoma {
                 double areaUsada = (prcAreaUsada > 1 ? 0.0 : prcAreaUsada) * areaDisponible[mes];
 
                 // Verificar suficiencia de agua
-                if (!esAguaSuficiente(aguaDisponible, requerimientoAgua, cultivo, mes, periodoCrecimiento, areaUsada, areaTotalDisponible)) {
+                if (!esAguaSuficiente(aguaDisponible, requerimientoAgua, cultivo, mes, periodoCrecimiento, areaUsada, areaTotalDisponible, gen)) {
+                    GA_CONTAR(RECHAZO_INICIALIZAR_AGUA);
                     continue;
                 }
 
-                // Asignar area a los arreglos genes y cultivoPlantado para los meses actuales y subsiguientes
-                for (int m = 0; m < periodoCrecimiento && (mes + m) < meses; ++m) {
-                    int indice = cultivo + numeroCultivos * (mes + m);
-                    nuevoCromosoma.genes[indice] += areaUsada;
-                    areaDisponible[mes + m] -= areaUsada;
-
-                    double areaEnHectareas = areaUsada * areaTotalDisponible;
-                    double aguaADeducir = requerimientoAgua[cultivo] * areaEnHectareas;
-
-                    if (aguaDisponible[mes + m] < aguaADeducir) {
-                        aguaADeducir = aguaDisponible[mes + m];
-                    }
-                    aguaDisponible[mes + m] -= aguaADeducir;
-                }
-
-                // Actualizar el arreglo cultivoPlantado
-                int indicePlantacion = cultivo + numeroCultivos * mes;
-                nuevoCromosoma.cultivoPlantado[indicePlantacion] = areaUsada;
+                sembrar(nuevoCromosoma, numeroCultivos, meses, cultivo, mes, periodoCrecimiento, areaUsada, requerimientoAgua,
+                        areaTotalDisponible, areaDisponible, aguaDisponible);
             }
 
             // Transferir agua no usada al siguiente mes
@@ -122,8 +142,6 @@ class Cromosoma {
                 aguaDisponible[mes + 1] += aguaDisponible[mes];  // Agregar agua restante al siguiente mes
             }
         }
-
-        return nuevoCromosoma;
     }
 
     void imprimirCromosoma(int numeroCultivos) const {
@@ -1,10 +1,66 @@
 #ifndef CULTIVACION_H
 #define CULTIVACION_H
 
+#include <algorithm>
 #include <vector>
 
 using namespace std;
 
+// Ventanas de siembra factibles de un escenario, calculadas una vez a partir de 'cultivable' y 'mesesCultivo':
+// si un cultivo puede sembrarse en un mes (todos los meses de su periodo de crecimiento dentro del horizonte
+// son cultivables) y la lista de cultivos que pueden sembrarse en cada mes
+class IndiceFactibilidad {
+   public:
+    // Reconstruir el indice si cambiaron las dimensiones, 'cultivable' o 'mesesCultivo'
+    void preparar(int numeroCultivos, int meses, const vector<int>& cultivable, const vector<int>& mesesCultivo) {
+        if (numeroCultivos == cultivos && meses == this->meses && cultivable == cultivableIndice && mesesCultivo == mesesCultivoIndice) return;
+        cultivos = numeroCultivos;
+        this->meses = meses;
+        cultivableIndice = cultivable;
+        mesesCultivoIndice = mesesCultivo;
+
+        inicioFactible.assign(static_cast<size_t>(cultivos) * meses, 0);
+        inicioMes.assign(meses + 1, 0);
+        cultivosFactibles.clear();
+        vector<int> racha(static_cast<size_t>(cultivos) * (meses + 1), 0);  // Meses cultivables seguidos desde cada mes
+        for (int mes = meses - 1; mes >= 0; --mes) {
+            for (int cultivo = 0; cultivo < cultivos; ++cultivo) {
+                int indice = cultivo + cultivos * mes;
+                racha[indice] = cultivable[indice] != 0 ? racha[indice + cultivos] + 1 : 0;
+            }
+        }
+        for (int mes = 0; mes < meses; ++mes) {
+            inicioMes[mes] = static_cast<int>(cultivosFactibles.size());
+            for (int cultivo = 0; cultivo < cultivos; ++cultivo) {
+                int indice = cultivo + cultivos * mes;
+                if (racha[indice] >= min(mesesCultivo[cultivo], meses - mes)) {
+                    inicioFactible[indice] = 1;
+                    cultivosFactibles.push_back(cultivo);
+                }
+            }
+        }
+        inicioMes[meses] = static_cast<int>(cultivosFactibles.size());
+    }
+
+    // Si el cultivo puede sembrarse en el mes, en O(1)
+    bool puedeSembrar(int cultivo, int mes) const {
+        return inicioFactible[cultivo + cultivos * mes] != 0;
+    }
+
+    // Cultivos que pueden sembrarse en el mes: cultivosEnMes(mes) valores a partir de primerCultivo(mes)
+    int cultivosEnMes(int mes) const { return inicioMes[mes + 1] - inicioMes[mes]; }
+    const int* primerCultivo(int mes) const { return cultivosFactibles.data() + inicioMes[mes]; }
+
+   private:
+    int cultivos = 0;
+    int meses = 0;
+    vector<int> cultivableIndice;     // Datos con los que se construyo el indice
+    vector<int> mesesCultivoIndice;
+    vector<char> inicioFactible;      // Matriz meses x cultivos, como 'cultivable'
+    vector<int> inicioMes;            // Posicion en cultivosFactibles de la lista de cada mes (meses + 1 valores)
+    vector<int> cultivosFactibles;    // Listas de cultivos factibles de todos los meses, una tras otra
+};
+
 class Cultivacion {
    public:
     vector<int> mesesCultivo = {4, 5, 3, 3, 4};                                       // Periodos de crecimiento de los cultivos
@@ -25,6 +81,13 @@ class Cultivacion {
     vector<double> susceptibilidadAgua = {2.0, 3.1, 4.1, 4.6, 3.3};             // Susceptibilidad al agua por cultivo
     double areaTotalDisponible = 100.0;                                         // Area total disponible
     double conductividadElectrica = 0.8;                                        // Conductividad electrica inicial
+    IndiceFactibilidad factibilidad;                                            // Derivado de cultivable y mesesCultivo
+
+    // Construir (o confirmar) el indice de factibilidad; se llama antes de repartir trabajo entre hilos
+    const IndiceFactibilidad& prepararFactibilidad(int numeroCultivos, int meses) {
+        factibilidad.preparar(numeroCultivos, meses, cultivable, mesesCultivo);
+        return factibilidad;
+    }
 
     // Constructor vacio
     Cultivacion() {};
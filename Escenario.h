@@ -0,0 +1,147 @@
+#ifndef ESCENARIO_H
+#define ESCENARIO_H
+
+#include <cstdint>
+#include <cstdlib>
+#include <istream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+#include "Cultivacion.h"
+
+// Comprobar los valores que deben ser positivos: cosechaEsperada divide por los meses de cada cultivo, y un
+// cultivo de cero meses o un area nula permitirian sembrar sin ocupar area ni agua. La usan tanto
+// Escenario::validar como el archivo binario, para rechazar lo mismo con el mismo mensaje
+inline bool valoresPositivos(const int* mesesCultivo, size_t cultivos, double areaTotalDisponible, string& error) {
+    for (size_t c = 0; c < cultivos; ++c) {
+        if (mesesCultivo[c] <= 0) {
+            error = "mesesCultivo debe tener valores positivos";
+            return false;
+        }
+    }
+    if (!(areaTotalDisponible > 0.0)) {
+        error = "areaTotalDisponible debe ser positiva";
+        return false;
+    }
+    return true;
+}
+
+// Un problema a resolver: los datos de la granja y la temporada, y los parametros de su corrida
+struct Escenario {
+    string nombre;                 // Identifica el escenario en los resultados
+    int numeroCultivos = 5;        // Numero de cultivos
+    int meses = 8;                 // Numero de meses
+    int tamanoPoblacion = 100;     // Tamano de la poblacion
+    int maximoGeneraciones = 100;  // Numero de generaciones
+    uint64_t semilla = 0;          // Semilla de la corrida
+    bool semillaDada = false;      // Si el archivo fijo la semilla; si no, se deriva de la semilla del lote
+    Cultivacion cultivacion;       // Datos del problema; lo que el archivo no da queda con los valores por omision
+
+    // Trabajo aproximado de la corrida, para repartir primero los escenarios mas largos
+    double costo() const {
+        return static_cast<double>(tamanoPoblacion) * maximoGeneraciones * numeroCultivos * meses;
+    }
+
+    // Comprobar que las tablas tienen el tamano que piden numeroCultivos y meses, y que los valores son validos
+    bool validar(string& error) const {
+        const Cultivacion& c = cultivacion;
+        size_t cultivos = numeroCultivos, celdas = static_cast<size_t>(numeroCultivos) * meses;
+        if (numeroCultivos <= 0 || meses <= 0 || tamanoPoblacion < 2 || maximoGeneraciones < 0) {
+            error = "dimensiones o parametros no validos";
+        } else if (c.mesesCultivo.size() != cultivos || c.requerimientoAgua.size() != cultivos ||
+                   c.reduccionRendimiento.size() != cultivos || c.salinidadCritica.size() != cultivos ||
+                   c.maxCosechaPorArea.size() != cultivos || c.cambioSalinidadPorArea.size() != cultivos ||
+                   c.susceptibilidadAgua.size() != cultivos) {
+            error = "las tablas por cultivo deben tener " + to_string(cultivos) + " valores";
+        } else if (c.aguaInicialDisponible.size() != static_cast<size_t>(meses)) {
+            error = "aguaInicialDisponible debe tener " + to_string(meses) + " valores";
+        } else if (c.cultivable.size() != celdas) {
+            error = "cultivable debe tener " + to_string(celdas) + " valores";
+        } else if (valoresPositivos(c.mesesCultivo.data(), cultivos, c.areaTotalDisponible, error)) {
+            return true;
+        }
+        error = "escenario " + nombre + ": " + error;
+        return false;
+    }
+};
+
+// Leer los valores restantes de la linea en 'tabla'
+template <class T>
+inline bool leerTabla(istringstream& linea, vector<T>& tabla) {
+    tabla.clear();
+    T valor;
+    while (linea >> valor) tabla.push_back(valor);
+    return linea.eof() && !tabla.empty();
+}
+
+// Formato de texto de una lista de escenarios, una clave y sus valores por linea ('#' inicia un comentario):
+//
+//   escenario norte               <- empieza un escenario nuevo
+//   cultivos 5
+//   meses 8
+//   semilla 42                    <- opcional
+//   poblacion 100
+//   generaciones 100
+//   mesesCultivo 4 5 3 3 4        <- cualquier tabla o escalar de Cultivacion, con el nombre del miembro
+//   cultivable 1 1 1 ...          <- matriz meses x cultivos por filas
+//   areaTotalDisponible 100
+//
+// Devuelve false y el motivo en 'error' si el archivo no se puede interpretar o un escenario no es valido
+inline bool leerEscenarios(istream& entrada, vector<Escenario>& escenarios, string& error) {
+    string texto;
+    for (int numeroLinea = 1; getline(entrada, texto); ++numeroLinea) {
+        size_t comentario = texto.find('#');
+        if (comentario != string::npos) texto.erase(comentario);
+        istringstream linea(texto);
+        string clave;
+        if (!(linea >> clave)) continue;
+
+        if (clave == "escenario") {
+            escenarios.push_back(Escenario());
+            if (!(linea >> escenarios.back().nombre)) escenarios.back().nombre = to_string(escenarios.size());
+            continue;
+        }
+        if (escenarios.empty()) {
+            error = "linea " + to_string(numeroLinea) + ": falta la linea 'escenario NOMBRE'";
+            return false;
+        }
+
+        Escenario& e = escenarios.back();
+        Cultivacion& c = e.cultivacion;
+        bool correcto = true;
+        if (clave == "cultivos") correcto = static_cast<bool>(linea >> e.numeroCultivos);
+        else if (clave == "meses") correcto = static_cast<bool>(linea >> e.meses);
+        else if (clave == "poblacion") correcto = static_cast<bool>(linea >> e.tamanoPoblacion);
+        else if (clave == "generaciones") correcto = static_cast<bool>(linea >> e.maximoGeneraciones);
+        else if (clave == "semilla") correcto = e.semillaDada = static_cast<bool>(linea >> e.semilla);
+        else if (clave == "mesesCultivo") correcto = leerTabla(linea, c.mesesCultivo);
+        else if (clave == "requerimientoAgua") correcto = leerTabla(linea, c.requerimientoAgua);
+        else if (clave == "aguaInicialDisponible") correcto = leerTabla(linea, c.aguaInicialDisponible);
+        else if (clave == "cultivable") correcto = leerTabla(linea, c.cultivable);
+        else if (clave == "reduccionRendimiento") correcto = leerTabla(linea, c.reduccionRendimiento);
+        else if (clave == "salinidadCritica") correcto = leerTabla(linea, c.salinidadCritica);
+        else if (clave == "maxCosechaPorArea") correcto = leerTabla(linea, c.maxCosechaPorArea);
+        else if (clave == "cambioSalinidadPorArea") correcto = leerTabla(linea, c.cambioSalinidadPorArea);
+        else if (clave == "susceptibilidadAgua") correcto = leerTabla(linea, c.susceptibilidadAgua);
+        else if (clave == "areaTotalDisponible") correcto = static_cast<bool>(linea >> c.areaTotalDisponible);
+        else if (clave == "conductividadElectrica") correcto = static_cast<bool>(linea >> c.conductividadElectrica);
+        else {
+            error = "linea " + to_string(numeroLinea) + ": clave desconocida '" + clave + "'";
+            return false;
+        }
+        if (!correcto) {
+            error = "linea " + to_string(numeroLinea) + ": valores no validos para '" + clave + "'";
+            return false;
+        }
+    }
+
+    for (const Escenario& e : escenarios) {
+        if (!e.validar(error)) return false;
+    }
+    return true;
+}
+
+#endif /* ESCENARIO_H */
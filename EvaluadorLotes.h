@@ -0,0 +1,316 @@
+#ifndef EVALUADORLOTES_H
+#define EVALUADORLOTES_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+using namespace std;
+
+#include "CacheAptitud.h"
+#include "Cultivacion.h"
+#include "Poblacion.h"
+
+// En x86-64 con GCC/Clang y ELF se generan versiones AVX-512, AVX2 y base del nucleo y se elige al cargar
+#if defined(__GNUC__) && defined(__x86_64__) && defined(__ELF__)
+#define GA_CLONES_SIMD __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define GA_CLONES_SIMD
+#endif
+
+static const int CARRILES_LOTE = 16;  // Cromosomas evaluados juntos: dos registros AVX-512 o cuatro AVX2 de dobles
+
+// Constantes por cultivo que el nucleo por lotes lee en cada mes, con los factores fijos ya combinados
+struct ConstantesLote {
+    vector<double> aguaPorArea;          // requerimientoAgua * areaTotalDisponible
+    vector<double> cosechaPorMes;        // maxCosechaPorArea / mesesCultivo
+    vector<double> susceptibilidadAgua;
+    vector<double> reduccionRendimiento;  // Ya dividida entre 100
+    vector<double> salinidadCritica;
+    vector<double> cambioSalinidad;      // cambioSalinidadPorArea * areaTotalDisponible
+    vector<double> aguaInicialDisponible;
+    double conductividadElectrica = 0.0;
+    uint64_t huella = 0;                 // Huella de todas las constantes y dimensiones, base de las claves de la cache
+};
+
+// Espacio de trabajo de un hilo: genes del mes transpuestos y cultivos con algun carril plantado
+struct EspacioLote {
+    vector<double> genes;   // numeroCultivos x CARRILES_LOTE
+    vector<int> activos;    // Cultivos con area distinta de cero en al menos un carril
+    vector<TipoGen> ceros;  // Fila vacia que ocupa los carriles sobrantes del ultimo lote
+};
+
+// exp(x) para x en [-708, 0] sin saltos: reduccion x = k ln2 + r con |r| <= ln2/2, polinomio de Taylor de
+// grado 12 para e^r y escala 2^k armada en los bits del exponente. Error relativo menor a 2e-16.
+// El llamador recorta x a -708 (e^-708 ~ 3e-308, que frente a 1 - e^x es lo mismo que cero)
+inline double expNegativo(double x) {
+    const double LOG2E = 1.4426950408889634;
+    const double LN2_ALTO = 6.93147180369123816490e-01;
+    const double LN2_BAJO = 1.90821492927058770002e-10;
+    const double REDONDEO = 6755399441055744.0;  // 1.5 * 2^52: sumarlo deja k en los bits bajos de la mantisa
+
+    double t = x * LOG2E + REDONDEO;
+    double k = t - REDONDEO;
+    double r = (x - k * LN2_ALTO) - k * LN2_BAJO;
+
+    // Esquema de Estrin: cuatro cadenas cortas en lugar de una sola de Horner, para solapar los carriles
+    double r2 = r * r;
+    double r4 = r2 * r2;
+    double p0 = (1.0 + r) + r2 * (0.5 + r * (1.0 / 6.0));
+    double p1 = (1.0 / 24.0 + r * (1.0 / 120.0)) + r2 * (1.0 / 720.0 + r * (1.0 / 5040.0));
+    double p2 = (1.0 / 40320.0 + r * (1.0 / 362880.0)) + r2 * (1.0 / 3628800.0 + r * (1.0 / 39916800.0));
+    double p = p0 + r4 * (p1 + r4 * (p2 + r4 * (1.0 / 479001600.0)));
+
+    uint64_t bits;
+    memcpy(&bits, &t, sizeof(bits));
+    bits = (bits + 1023) << 52;  // 2^k: los bits altos de t salen por la izquierda
+    double escala;
+    memcpy(&escala, &bits, sizeof(escala));
+    return p * escala;
+}
+
+// Nucleo por lotes: evalua hasta CARRILES_LOTE cromosomas a la vez, un carril por cromosoma, siguiendo los
+// pasos de Generacion::funcionObjetivo. Los genes en cero se enmascaran en lugar de saltarse, asi todos los
+// carriles siguen el mismo camino; solo se omiten los cultivos sin area en ningun carril del lote.
+// Si 'iniciales' no es nulo, cada carril con estado arranca en mesInicial desde iniciales[l][mesInicial]
+// (los demas desde cero); si 'salidas' no es nulo se guarda en salidas[l][mes] el estado al empezar cada mes
+GA_CLONES_SIMD
+static void evaluarLoteCarriles(const TipoGen* const* filas, int carriles, int numeroCultivos, int meses,
+                                const ConstantesLote& k, EspacioLote& espacio, int mesInicial,
+                                const EstadoMes* const* iniciales, EstadoMes* const* salidas, double* resultado) {
+    const int L = CARRILES_LOTE;
+    double* bloque = espacio.genes.data();
+    int* activos = espacio.activos.data();
+    double cosechaTotal[L], conductividad[L], aguaArrastrada[L];
+    for (int l = 0; l < L; ++l) {
+        cosechaTotal[l] = 0.0;
+        conductividad[l] = k.conductividadElectrica;
+        aguaArrastrada[l] = 0.0;
+        if (iniciales != nullptr && l < carriles && iniciales[l] != nullptr) {
+            cosechaTotal[l] = iniciales[l][mesInicial].cosechaAcumulada;
+            conductividad[l] = iniciales[l][mesInicial].conductividad;
+            aguaArrastrada[l] = iniciales[l][mesInicial].aguaArrastrada;
+        }
+    }
+    const int mesesAgua = static_cast<int>(k.aguaInicialDisponible.size());
+
+    for (int mes = mesInicial; mes < meses; ++mes) {
+        if (salidas != nullptr) {
+            for (int l = 0; l < carriles; ++l) {
+                salidas[l][mes].cosechaAcumulada = cosechaTotal[l];
+                salidas[l][mes].conductividad = conductividad[l];
+                salidas[l][mes].aguaArrastrada = aguaArrastrada[l];
+            }
+        }
+
+        // Transponer los genes del mes a bloque[cultivo][carril] y anotar los cultivos presentes
+        int desplazamiento = numeroCultivos * mes;
+        int numeroActivos = 0;
+        for (int c = 0; c < numeroCultivos; ++c) {
+            double* g = bloque + numeroActivos * L;
+            bool alguno = false;
+            for (int l = 0; l < L; ++l) {
+                g[l] = filas[l][desplazamiento + c];
+                alguno |= g[l] != 0;
+            }
+            if (alguno) activos[numeroActivos++] = c;
+        }
+
+        // Agua total requerida
+        double aguaRequerida[L];
+        for (int l = 0; l < L; ++l) aguaRequerida[l] = 0.0;
+        for (int a = 0; a < numeroActivos; ++a) {
+            const double* g = bloque + a * L;
+            double aguaPorArea = k.aguaPorArea[activos[a]];
+            for (int l = 0; l < L; ++l) {
+                aguaRequerida[l] += g[l] > 0 ? aguaPorArea * g[l] : 0.0;
+            }
+        }
+
+        // Coeficiente de agua con el agua del mes mas la arrastrada del anterior
+        double aguaMes[L], coeficienteAgua[L];
+        for (int l = 0; l < L; ++l) {
+            aguaMes[l] = k.aguaInicialDisponible[mes] + aguaArrastrada[l];
+            double cociente = min(1.0, max(0.0, aguaMes[l] / aguaRequerida[l]));
+            coeficienteAgua[l] = aguaRequerida[l] > 0 ? cociente : 1.0;
+        }
+
+        // Cosecha de cada cultivo; los genes <= 0 usan un area ficticia de 1 y su aporte se anula
+        double cosechaMensual[L];
+        for (int l = 0; l < L; ++l) cosechaMensual[l] = 0.0;
+        for (int a = 0; a < numeroActivos; ++a) {
+            const double* g = bloque + a * L;
+            int c = activos[a];
+            double cosechaPorMes = k.cosechaPorMes[c];
+            double susceptibilidad = k.susceptibilidadAgua[c];
+            double reduccion = k.reduccionRendimiento[c];
+            double critica = k.salinidadCritica[c];
+            double efectoSalinidad[L];
+            for (int l = 0; l < L; ++l) {
+                double efecto = 1.0 - reduccion * (conductividad[l] - critica);
+                efecto = efecto < 0.0 ? 0.0 : efecto;
+                efectoSalinidad[l] = efecto > 1.0 ? 1.0 : efecto;
+            }
+            // Cada paso en su propio bucle: con una sola seleccion por bucle GCC los vectoriza tambien en AVX2
+            double mascara[L], area[L], exponente[L];
+            for (int l = 0; l < L; ++l) {
+                mascara[l] = g[l] > 0 ? 1.0 : 0.0;
+                area[l] = g[l] > 0 ? g[l] : 1.0;
+            }
+            for (int l = 0; l < L; ++l) {
+                double x = -(coeficienteAgua[l] * susceptibilidad) / area[l];
+                exponente[l] = x < -708.0 ? -708.0 : x;
+            }
+            for (int l = 0; l < L; ++l) {
+                double efectoAgua = 1 - expNegativo(exponente[l]);
+                double cosechaReal = cosechaPorMes * area[l] * efectoAgua * efectoSalinidad[l];
+                cosechaMensual[l] += cosechaReal * mascara[l];
+            }
+        }
+
+        // Salinidad para el siguiente mes; los cultivos ausentes aportan cero
+        if (mes < meses - 1) {
+            double cambioTotal[L];
+            for (int l = 0; l < L; ++l) cambioTotal[l] = 0.0;
+            for (int a = 0; a < numeroActivos; ++a) {
+                const double* g = bloque + a * L;
+                double cambio = k.cambioSalinidad[activos[a]];
+                for (int l = 0; l < L; ++l) {
+                    cambioTotal[l] += cambio * g[l];
+                }
+            }
+            for (int l = 0; l < L; ++l) conductividad[l] += cambioTotal[l];
+        }
+
+        // Agua sobrante para el siguiente mes y cosecha acumulada
+        bool transferir = mes < mesesAgua - 1;
+        for (int l = 0; l < L; ++l) {
+            aguaArrastrada[l] = transferir ? max(0.0, aguaMes[l] - aguaRequerida[l]) : 0.0;
+            cosechaTotal[l] += cosechaMensual[l];
+        }
+    }
+
+    for (int l = 0; l < carriles; ++l) {
+        resultado[l] = cosechaTotal[l];
+    }
+}
+
+// Cota superior del valor que el nucleo da a una fila que reanuda en mesInicial con cosechaInicial acumulada:
+// la cosecha esperada de cada gen de los meses restantes sin los efectos del agua y la salinidad, que estan
+// entre 0 y 1. Se suma en el mismo orden que el nucleo (cultivos de cada mes, luego meses), asi que cada
+// termino y cada suma parcial quedan por encima de los del nucleo salvo por el redondeo
+inline double cotaSuperiorCosecha(VistaConstCromosoma cromosoma, const ConstantesLote& k, int numeroCultivos, int mesInicial,
+                                  int meses, double cosechaInicial) {
+    double cota = cosechaInicial;
+    for (int mes = mesInicial; mes < meses; ++mes) {
+        const TipoGen* g = cromosoma.genes.data() + static_cast<size_t>(numeroCultivos) * mes;
+        double cosechaMensual = 0.0;
+        for (int c = 0; c < numeroCultivos; ++c) {
+            cosechaMensual += g[c] > 0 ? k.cosechaPorMes[c] * g[c] : 0.0;
+        }
+        cota += cosechaMensual;
+    }
+    return cota;
+}
+
+// Evaluador de la funcion objetivo por lotes de CARRILES_LOTE filas contiguas de una Poblacion.
+// Coincide con Generacion::funcionObjetivo con error relativo menor a 1e-12: los factores fijos por cultivo
+// se combinan de antemano y la exponencial es expNegativo, asi que solo cambia el redondeo
+class EvaluadorLotes {
+   public:
+    ConstantesLote constantes;
+    vector<EspacioLote> espacios;  // Un espacio de trabajo por hilo
+
+    // Combinar las constantes del escenario; solo reserva memoria cuando cambian las dimensiones
+    void preparar(const Cultivacion& cultivacion, int numeroCultivos, int meses, int numeroHilos) {
+        ConstantesLote& k = constantes;
+        k.aguaPorArea.resize(numeroCultivos);
+        k.cosechaPorMes.resize(numeroCultivos);
+        k.reduccionRendimiento.resize(numeroCultivos);
+        k.cambioSalinidad.resize(numeroCultivos);
+        for (int c = 0; c < numeroCultivos; ++c) {
+            k.aguaPorArea[c] = cultivacion.requerimientoAgua[c] * cultivacion.areaTotalDisponible;
+            k.cosechaPorMes[c] = cultivacion.maxCosechaPorArea[c] / cultivacion.mesesCultivo[c];
+            k.reduccionRendimiento[c] = cultivacion.reduccionRendimiento[c] / 100.0;
+            k.cambioSalinidad[c] = cultivacion.cambioSalinidadPorArea[c] * cultivacion.areaTotalDisponible;
+        }
+        k.susceptibilidadAgua.assign(cultivacion.susceptibilidadAgua.begin(), cultivacion.susceptibilidadAgua.begin() + numeroCultivos);
+        k.salinidadCritica.assign(cultivacion.salinidadCritica.begin(), cultivacion.salinidadCritica.begin() + numeroCultivos);
+        k.aguaInicialDisponible.assign(cultivacion.aguaInicialDisponible.begin(), cultivacion.aguaInicialDisponible.end());
+        k.conductividadElectrica = cultivacion.conductividadElectrica;
+
+        // Cualquier cambio de escenario cambia la huella, asi que la cache nunca devuelve valores de otro escenario
+        uint64_t huella = static_cast<uint64_t>(numeroCultivos) << 32 | static_cast<uint32_t>(meses);
+        const vector<double>* tablas[] = {&k.aguaPorArea, &k.cosechaPorMes, &k.susceptibilidadAgua, &k.reduccionRendimiento,
+                                          &k.salinidadCritica, &k.cambioSalinidad, &k.aguaInicialDisponible};
+        for (const vector<double>* tabla : tablas) {
+            huella = calcularHuella(tabla->data(), static_cast<int>(tabla->size()), huella).clave;
+        }
+        k.huella = calcularHuella(&k.conductividadElectrica, 1, huella).clave;
+
+        if (static_cast<int>(espacios.size()) < numeroHilos) espacios.resize(numeroHilos);
+        for (EspacioLote& espacio : espacios) {
+            espacio.genes.resize(static_cast<size_t>(numeroCultivos) * CARRILES_LOTE);
+            espacio.activos.resize(numeroCultivos);
+            espacio.ceros.assign(static_cast<size_t>(numeroCultivos) * meses, 0.0);
+        }
+    }
+
+    int numeroLotes(const Poblacion& poblacion) const {
+        return (poblacion.size() + CARRILES_LOTE - 1) / CARRILES_LOTE;
+    }
+
+    // Evaluar el lote numero 'lote' de la poblacion y guardar sus valores objetivo
+    void evaluarLote(Poblacion& poblacion, int lote, int numeroCultivos, int meses, int hilo) {
+        int inicio = lote * CARRILES_LOTE;
+        int carriles = min(CARRILES_LOTE, poblacion.size() - inicio);
+        const TipoGen* filas[CARRILES_LOTE];
+        for (int l = 0; l < CARRILES_LOTE; ++l) {
+            filas[l] = l < carriles ? poblacion[inicio + l].genes.data() : espacios[hilo].ceros.data();
+        }
+        evaluarLoteCarriles(filas, carriles, numeroCultivos, meses, constantes, espacios[hilo], 0, nullptr, nullptr,
+                            poblacion.valoresObjetivo.data() + inicio);
+    }
+
+    // Evaluar el lote numero 'lote' de una lista de filas (las que no estaban en la cache) y guardar sus estados.
+    // Si hay 'padres', la fila indices[p] se reanuda desde el estado de la fila referencias[p] de 'padres' en el
+    // mes mesesInicio[p]; el lote arranca en el menor de esos meses, valido tambien para los demas carriles
+    void evaluarLote(Poblacion& poblacion, const vector<int>& indices, int lote, int numeroCultivos, int meses, int hilo,
+                     const Poblacion* padres = nullptr, const vector<int>* referencias = nullptr,
+                     const vector<int>* mesesInicio = nullptr) {
+        int inicio = lote * CARRILES_LOTE;
+        int carriles = min(CARRILES_LOTE, static_cast<int>(indices.size()) - inicio);
+        bool conEstados = poblacion.obtenerMesesEstado() == meses;
+        const TipoGen* filas[CARRILES_LOTE];
+        const EstadoMes* iniciales[CARRILES_LOTE];
+        EstadoMes* salidas[CARRILES_LOTE];
+        double resultado[CARRILES_LOTE];
+        int mesInicial = meses;
+        for (int l = 0; l < CARRILES_LOTE; ++l) {
+            filas[l] = l < carriles ? poblacion[indices[inicio + l]].genes.data() : espacios[hilo].ceros.data();
+            iniciales[l] = nullptr;
+            salidas[l] = conEstados && l < carriles ? poblacion.estadosFila(indices[inicio + l]) : nullptr;
+            int mes = 0;
+            if (padres != nullptr && l < carriles && (*referencias)[inicio + l] >= 0) {
+                iniciales[l] = padres->estadosFila((*referencias)[inicio + l]);
+                mes = (*mesesInicio)[inicio + l];
+            }
+            if (l < carriles) mesInicial = min(mesInicial, mes);
+        }
+        // Un carril que reanuda mas tarde que el lote copia los meses previos de su padre, que son los mismos
+        for (int l = 0; l < carriles; ++l) {
+            if (salidas[l] != nullptr && iniciales[l] != nullptr) {
+                copy(iniciales[l], iniciales[l] + mesInicial, salidas[l]);
+            }
+        }
+        evaluarLoteCarriles(filas, carriles, numeroCultivos, meses, constantes, espacios[hilo], mesInicial,
+                            padres != nullptr ? iniciales : nullptr, conEstados ? salidas : nullptr, resultado);
+        for (int l = 0; l < carriles; ++l) {
+            poblacion.valoresObjetivo[indices[inicio + l]] = resultado[l];
+            if (conEstados) poblacion.estadoValido[indices[inicio + l]] = 1;
+        }
+    }
+};
+
+#endif /* EVALUADORLOTES_H */
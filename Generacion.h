@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <cmath>
 #include <ctime>
+#include <functional>
 #include <iomanip>
 #include <iostream>
 #include <limits>
@@ -14,56 +15,114 @@
 using namespace std;
 
 #include "Cromosoma.h"
+#include "Aleatorio.h"
+#include "ArenaTrabajo.h"
+#include "CacheAptitud.h"
 #include "Cultivacion.h"
+#include "EvaluadorLotes.h"
+#include "Instrumentacion.h"
+#include "Muestreo.h"
+#include "PoolHilos.h"
+#include "Poblacion.h"
+#include "Seleccion.h"
+
+// Individuo candidato a sobrevivir: padres con indice < numero de padres, hijos despues
+struct Candidato {
+    double valor;
+    int indice;
+};
+
+// Orden de supervivencia: mayor valor objetivo primero; en empate, el que estaba antes (padres antes que hijos)
+inline bool mejorCandidato(const Candidato& a, const Candidato& b) {
+    return a.valor > b.valor || (a.valor == b.valor && a.indice < b.indice);
+}
 
 class Generacion {
    public:
-    int tamanoPoblacion = 100;       // Tamano de la poblacion
-    double tasaMutacion = 0.05;      // Parametros del algoritmo genetico
-    double tasaCruce = 0.8;          // Parametros del algoritmo genetico
-    vector<Cromosoma> poblacion;     // Vector de cromosomas
-    vector<double> valoresObjetivo;  // Valores de la funcion objetivo
-
-    Generacion() : tamanoPoblacion(100) {
-        poblacion.reserve(tamanoPoblacion);
-        valoresObjetivo.reserve(tamanoPoblacion);
-    }
-
-    Generacion(int tamanoPoblacion, int dimension) : tamanoPoblacion(tamanoPoblacion) {
-        for (int i = 0; i < tamanoPoblacion; ++i) {
-            poblacion.emplace_back(dimension);
-        }
-        valoresObjetivo.resize(tamanoPoblacion, 0.0);
-    }
+    int tamanoPoblacion = 100;           // Tamano de la poblacion
+    double tasaMutacion = 0.05;          // Parametros del algoritmo genetico
+    double tasaCruce = 0.8;              // Parametros del algoritmo genetico
+    Poblacion poblacion;                 // Genes, cultivoPlantado y valores objetivo de todos los cromosomas, contiguos
+    Poblacion hijos;                     // Filas de los hijos, reutilizadas en cada generacion
+    vector<Cromosoma> borradoresCruce;   // Dos cromosomas de trabajo por hilo donde se escribe el cruce
+    vector<ArenaTrabajo> arenas;         // Memoria de trabajo de los operadores, una por hilo, reiniciada en cada hijo
+    vector<Candidato> candidatos;        // (valor objetivo, indice) de padres e hijos para elegir sobrevivientes
+    vector<int> destinoPadres;           // Posicion final de cada padre que sobrevive (-1 si no sobrevive)
+    vector<char> filaColocada;           // Marca de las filas ya ocupadas por su sobreviviente
+    Poblacion filaTemporal;              // Fila auxiliar (con sus estados) para rotar ciclos de padres al compactar
+    vector<pair<int, int> > padresHijos; // Padres de cada fila de hijos, para reanudar su evaluacion
+    EvaluadorLotes evaluador;            // Funcion objetivo vectorizada por lotes de cromosomas
+    CacheAptitud cacheAptitud;           // Valores objetivo ya calculados, por contenido de los genes
+    vector<HuellaCromosoma> huellas;     // Huella de cada fila de la poblacion que se esta evaluando
+    vector<char> filaEnCache;            // Filas cuyo valor salio de la cache
+    vector<int> filasPendientes;         // Filas que hay que evaluar de verdad
+    vector<int> referenciaFila;          // Padre desde cuyo estado se reanuda cada fila (-1 = desde el mes 0)
+    vector<int> mesInicioFila;           // Primer mes en que la fila difiere de ese padre
+    vector<int> referenciasPendientes;   // referenciaFila y mesInicioFila en el orden de filasPendientes
+    vector<int> mesesPendientes;
+    uint64_t mesesEvaluados = 0;         // Meses recorridos por el nucleo, por carril
+    uint64_t mesesOmitidos = 0;          // Meses reutilizados del estado de un padre
+    bool podarPorCota = true;            // Descartar sin evaluar los hijos cuya cota superior no alcanza a sobrevivir
+    vector<double> valoresCorte;         // Copia de los valores de los padres para hallar el del ultimo sobreviviente
+    vector<char> filaDescartada;         // Filas que la cota descarto sin evaluarlas
+    uint64_t hijosAcotados = 0;          // Hijos de las generaciones en que habia corte, descartados o no
+    uint64_t hijosDescartados = 0;       // Hijos descartados por la cota sin pasar por la cache ni el nucleo
+    OperadorSeleccion seleccion;         // Como se eligen los padres de cada pareja (por omision, uniforme)
+    TipoMuestreo muestreo = MUESTREO_RECHAZO;  // Como se sortean las siembras al inicializar y al ajustar areas
+    PoolHilos* poolHilos = nullptr;      // Pool compartido para generar hijos y evaluar en paralelo (nullptr = secuencial)
+    uint64_t semilla = 0;                // Semilla base de todos los flujos aleatorios
+    unsigned long numeroGeneracion = 0;  // Contador de generaciones, distingue los flujos de cada generacion
+
+    Generacion() : tamanoPoblacion(100) {}
+
+    Generacion(int tamanoPoblacion, int dimension) : tamanoPoblacion(tamanoPoblacion), poblacion(tamanoPoblacion, dimension) {}
 
     void inicializarCromosomas(int numeroCultivos, int meses, Cultivacion& cultivacion) {
         int dimension = numeroCultivos * meses;
-
-        for (int k = 0; k < tamanoPoblacion; ++k) {
-            Cromosoma nuevoCromosoma = Cromosoma::inicializar(dimension, numeroCultivos, meses,
-                                                              cultivacion.mesesCultivo,
-                                                              cultivacion.requerimientoAgua,
-                                                              cultivacion.cultivable,
-                                                              cultivacion.aguaInicialDisponible,
-                                                              cultivacion.areaTotalDisponible);
-            poblacion.push_back(nuevoCromosoma);
-        }
+        int inicio = poblacion.size();
+        poblacion.redimensionar(inicio + tamanoPoblacion, dimension);
+        const IndiceFactibilidad& factibilidad = cultivacion.prepararFactibilidad(numeroCultivos, meses);
+        prepararArenas();
+
+        // La poblacion inicial usa los flujos de la generacion 0, uno por individuo
+        ejecutarEnParalelo(tamanoPoblacion, [&](int k, int hilo) {
+            GA_MEDIR_FASE(FASE_INICIALIZACION);
+            GeneradorAleatorio gen = crearGenerador(0, k);
+            ArenaTrabajo& arena = arenas[hilo];
+            arena.reiniciar();
+            if (muestreo == MUESTREO_CONSTRUCTIVO) {
+                MuestreoSiembra::inicializar(poblacion[inicio + k], numeroCultivos, meses, cultivacion.mesesCultivo,
+                                             cultivacion.requerimientoAgua, factibilidad, cultivacion.aguaInicialDisponible,
+                                             cultivacion.areaTotalDisponible, arena, gen);
+                return;
+            }
+            Cromosoma::inicializar(poblacion[inicio + k], numeroCultivos, meses,
+                                   cultivacion.mesesCultivo,
+                                   cultivacion.requerimientoAgua,
+                                   factibilidad,
+                                   cultivacion.aguaInicialDisponible,
+                                   cultivacion.areaTotalDisponible, arena, gen);
+        });
     }
 
-    void inicializarHijoValidado(Cromosoma& hijoValidado, const Cromosoma& hijo) {
-        hijoValidado.genes.assign(hijo.genes.size(), 0.0);
-        hijoValidado.cultivoPlantado.assign(hijo.cultivoPlantado.size(), 0.0);
+    void inicializarHijoValidado(VistaCromosoma hijoValidado) {
+        hijoValidado.limpiar();
     }
 
-    vector<int> generarSecuenciaAleatoriaCultivos(int numeroCultivos, mt19937& gen) {
-        vector<int> secuenciaCultivos(numeroCultivos);
+    void generarSecuenciaAleatoriaCultivos(Fila<int> secuenciaCultivos, GeneradorAleatorio& gen) {
         iota(secuenciaCultivos.begin(), secuenciaCultivos.end(), 0);  // Llenar con 0, 1, 2, ..., numeroCultivos - 1
         shuffle(secuenciaCultivos.begin(), secuenciaCultivos.end(), gen);
-        return secuenciaCultivos;
     }
 
-    double ajustarAreaAsignada(double areaAsignada, double areaDisponible, mt19937& gen) {
-        if (areaAsignada > areaDisponible) {
+    double ajustarAreaAsignada(double areaAsignada, double areaDisponible, GeneradorAleatorio& gen) {
+        return ajustarAreaAsignada(areaAsignada, areaDisponible, muestreo, gen);
+    }
+
+    // Recortar el area de una siembra que no cabe en el area disponible del mes a un porcentaje al azar de ella
+    static double ajustarAreaAsignada(double areaAsignada, double areaDisponible, TipoMuestreo muestreo, GeneradorAleatorio& gen) {
+        if (areaAsignada > areaDisponible && muestreo == MUESTREO_CONSTRUCTIVO) {
+            areaAsignada = MuestreoSiembra::porcentajeAreaTruncado(gen) * areaDisponible;
+        } else if (areaAsignada > areaDisponible) {
             chi_squared_distribution<> dist(5);
             double prcAreaUsada;
             do {
@@ -74,7 +133,7 @@ class Generacion {
         return areaAsignada;
     }
 
-    void actualizarHijoValidado(Cromosoma& hijoValidado, vector<double>& areaDisponible, double areaAsignada,
+    void actualizarHijoValidado(VistaCromosoma hijoValidado, Fila<double> areaDisponible, double areaAsignada,
                                 int cultivo, int mes, int numeroCultivos, int meses, const Cultivacion& cultivacion) {
         for (int m = 0; m < cultivacion.mesesCultivo[cultivo] && (mes + m) < meses; ++m) {
             int indiceSubsecuente = cultivo + numeroCultivos * (mes + m);
@@ -90,43 +149,63 @@ class Generacion {
         }
     }
 
-    void validarHijo(const Cromosoma& hijo, int numeroCultivos, int meses, Cultivacion& cultivacion, Cromosoma& hijoValidado) {
+    // Validar el hijo en hijoValidado. En siembrasPorMes queda cuantos genes de cultivoPlantado sembro en cada
+    // mes, que la mutacion usa para elegir un gen sin recorrer todo el cromosoma
+    void validarHijo(VistaConstCromosoma hijo, int numeroCultivos, int meses, Cultivacion& cultivacion, VistaCromosoma hijoValidado,
+                     Fila<int> siembrasPorMes, ArenaTrabajo& arena, GeneradorAleatorio& gen) {
+        GA_MEDIR_FASE(FASE_VALIDACION);
         // Inicializar hijo validado
-        inicializarHijoValidado(hijoValidado, hijo);
-
-        random_device rd;
-        mt19937 gen(rd());
+        inicializarHijoValidado(hijoValidado);
 
-        vector<double> areaDisponible(meses, 1.0);
+        Fila<double> areaDisponible = arena.reservar(meses, 1.0);
+        Fila<int> secuenciaCultivos = arena.reservar<int>(numeroCultivos);  // Se vuelve a barajar en cada mes
 
         for (int mes = 0; mes < meses; ++mes) {
-            vector<int> secuenciaCultivos = generarSecuenciaAleatoriaCultivos(numeroCultivos, gen);
+            generarSecuenciaAleatoriaCultivos(secuenciaCultivos, gen);
 
+            int siembras = 0;
             for (int cultivo : secuenciaCultivos) {
                 int indice = cultivo + numeroCultivos * mes;
                 if (hijo.cultivoPlantado[indice] > 0.0) {
                     double areaAsignada = ajustarAreaAsignada(hijo.cultivoPlantado[indice], areaDisponible[mes], gen);
 
                     actualizarHijoValidado(hijoValidado, areaDisponible, areaAsignada, cultivo, mes, numeroCultivos, meses, cultivacion);
+                    if (hijoValidado.cultivoPlantado[indice] > 0.0) ++siembras;
                 }
             }
+            siembrasPorMes[mes] = siembras;
         }
     }
 
-    int seleccionarGenNoCeroAleatorio(const Cromosoma& cromosoma, int numeroCultivos, mt19937& gen) {
-        vector<int> indicesNoCero;
-        for (int i = 0; i < cromosoma.cultivoPlantado.size(); ++i) {
-            if (cromosoma.cultivoPlantado[i] > 0.0) {
-                indicesNoCero.push_back(i);
+    // Genes sembrados de cada mes de un cromosoma que no paso por validarHijo
+    static void contarSiembrasPorMes(VistaConstCromosoma cromosoma, int numeroCultivos, int meses, Fila<int> siembrasPorMes) {
+        for (int mes = 0; mes < meses; ++mes) {
+            int siembras = 0;
+            for (int cultivo = 0; cultivo < numeroCultivos; ++cultivo) {
+                if (cromosoma.cultivoPlantado[cultivo + numeroCultivos * mes] > 0.0) ++siembras;
             }
+            siembrasPorMes[mes] = siembras;
         }
-        if (indicesNoCero.empty()) return -1;  // No hay genes no cero para mutar
+    }
 
-        uniform_int_distribution<> indiceAleatorio(0, indicesNoCero.size() - 1);
-        return indicesNoCero[indiceAleatorio(gen)];
+    // Elegir al azar uno de los genes sembrados, en el orden de los indices. Con las siembras de cada mes se
+    // salta directamente al mes del elegido y solo se recorren sus cultivos
+    int seleccionarGenNoCeroAleatorio(VistaConstCromosoma cromosoma, int numeroCultivos, Fila<const int> siembrasPorMes,
+                                      GeneradorAleatorio& gen) {
+        int noCero = 0;
+        for (int siembras : siembrasPorMes) noCero += siembras;
+        if (noCero == 0) return -1;  // No hay genes no cero para mutar
+
+        uniform_int_distribution<> indiceAleatorio(0, noCero - 1);
+        int elegido = indiceAleatorio(gen);
+        int mes = 0;
+        while (elegido >= siembrasPorMes[mes]) elegido -= siembrasPorMes[mes++];
+        for (int i = numeroCultivos * mes;; ++i) {
+            if (cromosoma.cultivoPlantado[i] > 0.0 && elegido-- == 0) return i;
+        }
     }
 
-    double reducirAreaGen(Cromosoma& cromosoma, int indiceSeleccionado, mt19937& gen) {
+    double reducirAreaGen(VistaCromosoma cromosoma, int indiceSeleccionado, GeneradorAleatorio& gen) {
         uniform_real_distribution<> reduccionAleatoria(0.01, 0.1);  // Porcentaje de reduccion aleatoria
         double porcentajeReduccion = reduccionAleatoria(gen);
         double areaAReducir = cromosoma.cultivoPlantado[indiceSeleccionado] * porcentajeReduccion;
@@ -134,7 +213,7 @@ class Generacion {
         return areaAReducir;
     }
 
-    void actualizarGenTrasMutacion(Cromosoma& cromosoma, int indiceSeleccionado, double areaAReducir,
+    void actualizarGenTrasMutacion(VistaCromosoma cromosoma, int indiceSeleccionado, double areaAReducir,
                                    const Cultivacion& cultivacion, int numeroCultivos, int meses) {
         int mesSeleccionado = indiceSeleccionado / numeroCultivos;
         int cultivoSeleccionado = indiceSeleccionado % numeroCultivos;
@@ -145,34 +224,44 @@ class Generacion {
         }
     }
 
-    void reinicializarCromosoma(Cromosoma& cromosoma, int numeroCultivos, int meses, Cultivacion& cultivacion, mt19937& gen) {
-        vector<double> areaDisponible(meses, 1.0);                          // Reiniciar area disponible
-        vector<double> aguaDisponible = cultivacion.aguaInicialDisponible;  // Reiniciar disponibilidad de agua
+    // Area libre de un mes: 1 menos los genes del mes, sumados en orden de cultivo
+    static double areaLibreMes(VistaConstCromosoma cromosoma, int numeroCultivos, int mes) {
+        double areaLibre = 1.0;
+        for (int cultivo = 0; cultivo < numeroCultivos; ++cultivo) {
+            int indice = cultivo + numeroCultivos * mes;
+            if (cromosoma.genes[indice] > 0.0)
+                areaLibre -= cromosoma.genes[indice];
+        }
+        return areaLibre;
+    }
+
+    // A lo sumo una siembra nueva por mes. El area libre de un mes se suma de los genes solo cuando se usa: el
+    // del mes en curso y, si se siembra, los de su periodo de crecimiento. Da los mismos valores que volver a
+    // sumar todos los meses restantes en cada mes, pero en tiempo lineal en la dimension y en el periodo de
+    // cada siembra nueva. siembrasPorMes se mantiene al dia con las siembras nuevas
+    void reinicializarCromosoma(VistaCromosoma cromosoma, int numeroCultivos, int meses, Cultivacion& cultivacion, Fila<int> siembrasPorMes,
+                                ArenaTrabajo& arena, GeneradorAleatorio& gen) {
+        GA_MEDIR_FASE(FASE_REINICIALIZACION);
+        Fila<double> aguaDisponible = arena.copiar(cultivacion.aguaInicialDisponible);  // Reiniciar disponibilidad de agua
 
         for (int mes = 0; mes < meses; ++mes) {
-            // Recalcular area disponible para el mes actual y todos los meses siguientes
-            for (int m = mes; m < meses; ++m) {
-                areaDisponible[m] = 1.0;  // Reiniciar area disponible al maximo (100%)
-                for (int cultivo = 0; cultivo < numeroCultivos; ++cultivo) {
-                    int indice = cultivo + numeroCultivos * m;
-                    if (cromosoma.genes[indice] > 0.0)
-                        areaDisponible[m] -= cromosoma.genes[indice];
-                }
-            }
+            double areaDisponibleMes = areaLibreMes(cromosoma, numeroCultivos, mes);
             // Agregar nueva area aleatoria si es necesario
-            if (Cromosoma::debeEntrarAlBucleDeInicializacion(areaDisponible[mes])) {
+            if (Cromosoma::debeEntrarAlBucleDeInicializacion(areaDisponibleMes, gen)) {
                 // Elegir un cultivo aleatorio
-                int cultivo = rand() % numeroCultivos;
+                int cultivo = gen.enteroMenorQue(numeroCultivos);
                 int periodoCrecimiento = cultivacion.mesesCultivo[cultivo];
 
                 // Validar si es cultivable y hay suficiente agua
-                if (!Cromosoma::esCultivable(cultivacion.cultivable, cultivo, mes, periodoCrecimiento, numeroCultivos))
+                if (!cultivacion.factibilidad.puedeSembrar(cultivo, mes)) {
+                    GA_CONTAR(RECHAZO_REINICIALIZAR_CULTIVABLE);
                     continue;
+                }
 
                 // Determinar el area minima disponible durante el periodo de crecimiento
-                double areaMinimaDisponible = areaDisponible[mes];
+                double areaMinimaDisponible = areaDisponibleMes;
                 for (int m = 1; m < periodoCrecimiento && (mes + m) < meses; ++m)
-                    areaMinimaDisponible = min(areaMinimaDisponible, areaDisponible[mes + m]);
+                    areaMinimaDisponible = min(areaMinimaDisponible, areaLibreMes(cromosoma, numeroCultivos, mes + m));
 
                 // Determinar el area a usar
                 chi_squared_distribution<> dist(5);
@@ -180,14 +269,15 @@ class Generacion {
                 double areaUsada = (prcAreaUsada > 1 ? 0.0 : prcAreaUsada) * areaMinimaDisponible;
 
                 // Validar suficiencia de agua
-                if (!Cromosoma::esAguaSuficiente(aguaDisponible, cultivacion.requerimientoAgua, cultivo, mes, periodoCrecimiento, areaUsada, cultivacion.areaTotalDisponible))
+                if (!Cromosoma::esAguaSuficiente(aguaDisponible, cultivacion.requerimientoAgua, cultivo, mes, periodoCrecimiento, areaUsada, cultivacion.areaTotalDisponible, gen)) {
+                    GA_CONTAR(RECHAZO_REINICIALIZAR_AGUA);
                     continue;
+                }
 
                 // Asignar area a genes y cultivoPlantado
                 for (int m = 0; m < periodoCrecimiento && (mes + m) < meses; ++m) {
                     int indice = cultivo + numeroCultivos * (mes + m);
                     cromosoma.genes[indice] += areaUsada;
-                    areaDisponible[mes + m] -= areaUsada;
 
                     double areaEnHectareas = areaUsada * cultivacion.areaTotalDisponible;
                     double aguaADeducir = cultivacion.requerimientoAgua[cultivo] * areaEnHectareas;
@@ -197,14 +287,19 @@ class Generacion {
                 }
 
                 int indicePlantacion = cultivo + numeroCultivos * mes;
+                bool sembrado = cromosoma.cultivoPlantado[indicePlantacion] > 0.0;
                 cromosoma.cultivoPlantado[indicePlantacion] += areaUsada;
+                if (!sembrado && cromosoma.cultivoPlantado[indicePlantacion] > 0.0) ++siembrasPorMes[mes];
             }
         }
     }
 
-    void mutarCromosoma(Cromosoma& cromosoma, int numeroCultivos, int meses, Cultivacion& cultivacion, mt19937& gen) {
+    // Mutar un cromosoma cuyas siembras por mes estan en siembrasPorMes (de validarHijo o contarSiembrasPorMes)
+    void mutarCromosoma(VistaCromosoma cromosoma, int numeroCultivos, int meses, Cultivacion& cultivacion, Fila<int> siembrasPorMes,
+                        ArenaTrabajo& arena, GeneradorAleatorio& gen) {
+        GA_MEDIR_FASE(FASE_MUTACION);
         // Seleccionar un gen aleatorio para mutar
-        int indiceSeleccionado = seleccionarGenNoCeroAleatorio(cromosoma, numeroCultivos, gen);
+        int indiceSeleccionado = seleccionarGenNoCeroAleatorio(cromosoma, numeroCultivos, siembrasPorMes, gen);
         if (indiceSeleccionado == -1) return;  // No es posible mutar
 
         // Reducir el area del gen seleccionado
@@ -214,107 +309,229 @@ class Generacion {
         actualizarGenTrasMutacion(cromosoma, indiceSeleccionado, areaAReducir, cultivacion, numeroCultivos, meses);
 
         // Reinicializar el cromosoma mutado
-        reinicializarCromosoma(cromosoma, numeroCultivos, meses, cultivacion, gen);
+        reinicializarCromosoma(cromosoma, numeroCultivos, meses, cultivacion, siembrasPorMes, arena, gen);
     }
 
-    pair<Cromosoma, Cromosoma> seleccionarPadres() {
-        random_device rd;
-        mt19937 gen(rd());
-        uniform_int_distribution<> dist(0, tamanoPoblacion - 1);
+    // Elegir los dos padres de una pareja con el operador de seleccion; se devuelven sus indices en la
+    // poblacion, sin copiarlos
+    pair<int, int> seleccionarPadres(int pareja, GeneradorAleatorio& gen) {
+        GA_MEDIR_FASE(FASE_SELECCION);
+        return seleccion.elegirPadres(pareja, gen);
+    }
 
-        Cromosoma padre1 = poblacion[dist(gen)];
-        Cromosoma padre2 = poblacion[dist(gen)];
+    // Cruce de un punto: hijo1 toma los meses anteriores al punto de padre1 y el resto de padre2 (hijo2 al reves).
+    // Los hijos se escriben en filas ya reservadas por el llamador
+    void realizarCruce(VistaConstCromosoma padre1, VistaConstCromosoma padre2, int numeroCultivos, int meses,
+                       VistaCromosoma hijo1, VistaCromosoma hijo2, GeneradorAleatorio& gen) {
+        GA_MEDIR_FASE(FASE_CRUCE);
+        int puntoCruce = meses;  // Sin cruce los hijos son copias de los padres
+        if (gen.uniforme() < tasaCruce) {
+            uniform_int_distribution<> distMes(0, meses - 1);
+            puntoCruce = distMes(gen);
+        }
 
-        return std::make_pair(padre1, padre2);
+        int corte = numeroCultivos * puntoCruce;
+        int dimension = numeroCultivos * meses;
+        copy(padre1.genes.begin(), padre1.genes.begin() + corte, hijo1.genes.begin());
+        copy(padre2.genes.begin() + corte, padre2.genes.begin() + dimension, hijo1.genes.begin() + corte);
+        copy(padre1.cultivoPlantado.begin(), padre1.cultivoPlantado.begin() + corte, hijo1.cultivoPlantado.begin());
+        copy(padre2.cultivoPlantado.begin() + corte, padre2.cultivoPlantado.begin() + dimension, hijo1.cultivoPlantado.begin() + corte);
+
+        copy(padre2.genes.begin(), padre2.genes.begin() + corte, hijo2.genes.begin());
+        copy(padre1.genes.begin() + corte, padre1.genes.begin() + dimension, hijo2.genes.begin() + corte);
+        copy(padre2.cultivoPlantado.begin(), padre2.cultivoPlantado.begin() + corte, hijo2.cultivoPlantado.begin());
+        copy(padre1.cultivoPlantado.begin() + corte, padre1.cultivoPlantado.begin() + dimension, hijo2.cultivoPlantado.begin() + corte);
     }
 
-    pair<Cromosoma, Cromosoma> realizarCruce(const Cromosoma& padre1, const Cromosoma& padre2, int numeroCultivos, int meses) {
-        random_device rd;
-        mt19937 gen(rd());
+    // Validar el hijo y mutarlo, escribiendo el resultado directamente en la fila de destino. Los arreglos
+    // temporales de ambos pasos salen de 'arena', que se reinicia aqui una vez por hijo
+    void validarYMutar(VistaConstCromosoma hijo, int numeroCultivos, int meses, Cultivacion& cultivacion, VistaCromosoma hijoValidado,
+                       ArenaTrabajo& arena, GeneradorAleatorio& gen) {
+        arena.reiniciar();
+        Fila<int> siembrasPorMes = arena.reservar<int>(meses);
+        validarHijo(hijo, numeroCultivos, meses, cultivacion, hijoValidado, siembrasPorMes, arena, gen);
 
-        if (uniform_real_distribution<>(0.0, 1.0)(gen) >= tasaCruce) {
-            return std::make_pair(padre1, padre2);  // No se realiza cruce, devolver los padres como hijos
+        if (gen.uniforme() < tasaMutacion) {
+            mutarCromosoma(hijoValidado, numeroCultivos, meses, cultivacion, siembrasPorMes, arena, gen);
         }
+    }
 
-        uniform_int_distribution<> distMes(0, meses - 1);
-        int puntoCruce = distMes(gen);
+    void agregarAPoblacion(const Cromosoma& cromosoma) {
+        poblacion.agregar(cromosoma);
+    }
 
-        Cromosoma hijo1 = padre1;
-        Cromosoma hijo2 = padre2;
+    // Quedarse con los tamanoPoblacion mejores entre la poblacion actual y los hijos.
+    // Los padres ya tienen su valor objetivo; solo se evaluan los hijos, y con podarPorCota no se evaluan los
+    // que no pueden sobrevivir. La seleccion trabaja sobre pares (valor, indice) con nth_element y solo ordena
+    // a los sobrevivientes; despues se colocan en su lugar
+    void combinarGeneraciones(Poblacion& descendencia, int numeroCultivos, int meses, Cultivacion& cultivacion) {
+        int tamanoActual = poblacion.size();
+        int tamanoCombinado = tamanoActual + descendencia.size();
+        double corte = podarPorCota ? valorCorte(min(tamanoPoblacion, tamanoCombinado)) : -numeric_limits<double>::infinity();
+        evaluarPoblacion(descendencia, numeroCultivos, meses, cultivacion, &poblacion, &padresHijos, corte);
+
+        GA_MEDIR_FASE(FASE_COMBINACION);
+        candidatos.resize(tamanoCombinado);
+        for (int i = 0; i < tamanoActual; ++i) {
+            candidatos[i].valor = poblacion.valoresObjetivo[i];
+            candidatos[i].indice = i;
+        }
+        for (int i = 0; i < descendencia.size(); ++i) {
+            candidatos[tamanoActual + i].valor = descendencia.valoresObjetivo[i];
+            candidatos[tamanoActual + i].indice = tamanoActual + i;
+        }
 
-        for (int mes = puntoCruce; mes < meses; ++mes) {
-            for (int cultivo = 0; cultivo < numeroCultivos; ++cultivo) {
-                int indice = cultivo + numeroCultivos * mes;
-                swap(hijo1.genes[indice], hijo2.genes[indice]);
-                swap(hijo1.cultivoPlantado[indice], hijo2.cultivoPlantado[indice]);
-            }
+        int sobrevivientes = min(tamanoPoblacion, tamanoCombinado);
+        if (sobrevivientes < tamanoCombinado) {
+            nth_element(candidatos.begin(), candidatos.begin() + sobrevivientes, candidatos.end(), mejorCandidato);
         }
+        sort(candidatos.begin(), candidatos.begin() + sobrevivientes, mejorCandidato);
 
-        return std::make_pair(hijo1, hijo2);
+        // Seleccionar los mejores individuos para la siguiente generación
+        compactarSobrevivientes(descendencia, sobrevivientes);
     }
 
-    Cromosoma validarYMutar(Cromosoma hijo, int numeroCultivos, int meses, Cultivacion& cultivacion) {
-        Cromosoma hijoValidado;
-        validarHijo(hijo, numeroCultivos, meses, cultivacion, hijoValidado);
+    // Valor del padre que queda en el rango 'sobrevivientes' - 1 entre los padres. Si hay tantos padres, al menos
+    // 'sobrevivientes' padres valen eso o mas y en un empate el padre gana al hijo, asi que un hijo que no vale
+    // mas que el corte no sobrevive. Sin padres suficientes no hay corte (-infinito)
+    double valorCorte(int sobrevivientes) {
+        int tamanoActual = poblacion.size();
+        if (sobrevivientes <= 0 || tamanoActual < sobrevivientes) return -numeric_limits<double>::infinity();
+        valoresCorte.assign(poblacion.valoresObjetivo.begin(), poblacion.valoresObjetivo.begin() + tamanoActual);
+        nth_element(valoresCorte.begin(), valoresCorte.begin() + (sobrevivientes - 1), valoresCorte.end(), greater<double>());
+        return valoresCorte[sobrevivientes - 1];
+    }
+
+    // Colocar al sobreviviente de rango r en la fila r de la poblacion sin un buffer del tamano de la poblacion.
+    // Cada padre que sobrevive se mueve a su rango; se siguen primero las cadenas que empiezan en una fila libre
+    // y al final los ciclos entre padres, que se rotan con una sola fila auxiliar
+    void compactarSobrevivientes(const Poblacion& descendencia, int sobrevivientes) {
+        int tamanoActual = poblacion.size();
+        if (tamanoActual < sobrevivientes) poblacion.redimensionar(sobrevivientes);
+
+        destinoPadres.assign(tamanoActual, -1);
+        for (int r = 0; r < sobrevivientes; ++r) {
+            if (candidatos[r].indice < tamanoActual) destinoPadres[candidatos[r].indice] = r;
+        }
+        filaColocada.assign(sobrevivientes, 0);
+
+        // Copiar en la fila 'fila' a su sobreviviente; devuelve la fila de padre que queda libre o -1
+        auto colocar = [&](int fila) {
+            int origen = candidatos[fila].indice;
+            filaColocada[fila] = 1;
+            if (origen >= tamanoActual) {
+                poblacion.copiarFila(fila, descendencia, origen - tamanoActual);
+                return -1;
+            }
+            if (origen != fila) poblacion.copiarFila(fila, poblacion, origen);
+            return origen != fila && origen < sobrevivientes ? origen : -1;
+        };
+
+        // Cadenas: la fila esta libre si su padre no sobrevive (o no habia padre en ella)
+        for (int r = 0; r < sobrevivientes; ++r) {
+            bool libre = r >= tamanoActual || destinoPadres[r] < 0;
+            for (int fila = libre ? r : -1; fila >= 0 && !filaColocada[fila];) {
+                fila = colocar(fila);
+            }
+        }
 
-        random_device rd;
-        mt19937 gen(rd());
-        if (uniform_real_distribution<>(0, 1)(gen) < tasaMutacion) {
-            mutarCromosoma(hijoValidado, numeroCultivos, meses, cultivacion, gen);
+        // Ciclos: todas sus filas estan ocupadas por padres que sobreviven en otra posicion
+        for (int r = 0; r < sobrevivientes; ++r) {
+            if (filaColocada[r]) continue;
+            filaTemporal.redimensionar(1, poblacion.obtenerDimension());
+            filaTemporal.prepararEstados(poblacion.obtenerMesesEstado());
+            filaTemporal.copiarFila(0, poblacion, r);
+
+            int fila = r;
+            while (candidatos[fila].indice != r) {
+                int origen = candidatos[fila].indice;
+                poblacion.copiarFila(fila, poblacion, origen);
+                filaColocada[fila] = 1;
+                fila = origen;
+            }
+            poblacion.copiarFila(fila, filaTemporal, 0);
+            filaColocada[fila] = 1;
         }
 
-        return hijoValidado;
+        poblacion.redimensionar(sobrevivientes);
     }
 
-    void agregarAPoblacion(const Cromosoma& cromosoma) {
-        poblacion.push_back(cromosoma);
+    // Ejecutar tarea(indice, hilo) para cada indice, en el pool si existe o en este hilo si no
+    template <class Tarea>
+    void ejecutarEnParalelo(int total, const Tarea& tarea, int tamanoBloque = 1) {
+        if (poolHilos != nullptr) {
+            poolHilos->paraCada(total, tarea, tamanoBloque);
+        } else {
+            for (int i = 0; i < total; ++i) tarea(i, 0);
+        }
     }
 
-    void combinarGeneraciones(Generacion& siguienteGeneracion, int numeroCultivos, int meses, Cultivacion& cultivacion) {
-        Generacion generacionCombinada;
-        generacionCombinada.poblacion.insert(generacionCombinada.poblacion.end(), poblacion.begin(), poblacion.end());
-        generacionCombinada.poblacion.insert(generacionCombinada.poblacion.end(), siguienteGeneracion.poblacion.begin(), siguienteGeneracion.poblacion.end());
+    int numeroHilos() const {
+        return poolHilos != nullptr ? poolHilos->numeroHilos() : 1;
+    }
 
-        generacionCombinada.inicializarValoresObjetivo(numeroCultivos, meses, cultivacion);
+    // Flujo aleatorio propio de cada tarea: depende solo de la semilla, la generacion y el indice de la tarea,
+    // asi el resultado es el mismo sin importar cuantos hilos se usen ni en que orden terminen
+    GeneradorAleatorio crearGenerador(unsigned long generacion, int tarea) const {
+        return GeneradorAleatorio(semilla, (static_cast<uint64_t>(generacion) << 32) | static_cast<uint32_t>(tarea));
+    }
 
-        sort(generacionCombinada.poblacion.begin(), generacionCombinada.poblacion.end(), [](const Cromosoma& a, const Cromosoma& b) {
-            return a.valorObjetivo > b.valorObjetivo;
-        });
+    // Reservar las filas de hijos y los cromosomas de trabajo del cruce; solo reserva memoria la primera vez
+    void prepararBuffers(int numeroHijos, int dimension) {
+        hijos.redimensionar(numeroHijos, dimension);
+        padresHijos.resize(numeroHijos);
+        int borradoresNecesarios = 2 * numeroHilos();
+        if (static_cast<int>(borradoresCruce.size()) < borradoresNecesarios ||
+            static_cast<int>(borradoresCruce[0].genes.size()) != dimension) {
+            borradoresCruce.assign(borradoresNecesarios, Cromosoma(dimension));
+        }
+        prepararArenas();
+    }
 
-        // Seleccionar los mejores individuos para la siguiente generación
-        poblacion.clear();
-        poblacion.insert(poblacion.end(), generacionCombinada.poblacion.begin(), generacionCombinada.poblacion.begin() + tamanoPoblacion);
+    // Una arena por hilo; las que ya existen conservan la memoria que reservaron. Todas se llevan a la capacidad
+    // de la mas grande, para que un hilo que recibe pocos hijos no siga creciendo generaciones despues que los demas
+    void prepararArenas() {
+        if (static_cast<int>(arenas.size()) < numeroHilos()) arenas.resize(numeroHilos());
+        size_t capacidadMaxima = 0;
+        for (const ArenaTrabajo& arena : arenas) capacidadMaxima = max(capacidadMaxima, arena.capacidad());
+        for (ArenaTrabajo& arena : arenas) arena.asegurarCapacidad(capacidadMaxima);
     }
 
     void obtenerNuevaGeneracion(int tamanoPoblacion, int numeroCultivos, int meses, Cultivacion& cultivacion) {
-        Generacion siguienteGeneracion;
+        prepararBuffers(2 * (tamanoPoblacion / 2), poblacion.obtenerDimension());
+        cultivacion.prepararFactibilidad(numeroCultivos, meses);  // Antes de repartir parejas entre hilos
+        ++numeroGeneracion;
+
+        // Tablas de seleccion de la generacion, con un flujo aleatorio propio que no usa ninguna pareja
+        {
+            GA_MEDIR_FASE(FASE_SELECCION);
+            seleccion.preparar(poblacion.valoresObjetivo.data(), tamanoPoblacion, tamanoPoblacion / 2, crearGenerador(numeroGeneracion, -1));
+        }
+
+        ejecutarEnParalelo(tamanoPoblacion / 2, [&](int i, int hilo) {
+            GeneradorAleatorio gen = crearGenerador(numeroGeneracion, i);
 
-        for (int i = 0; i < tamanoPoblacion / 2; ++i) {
             // Seleccionar padres
-            pair<Cromosoma, Cromosoma> padres = seleccionarPadres();
-            Cromosoma padre1 = padres.first;
-            Cromosoma padre2 = padres.second;
-
-            // Realizar cruce
-            pair<Cromosoma, Cromosoma> hijos = realizarCruce(padre1, padre2, numeroCultivos, meses);
-            Cromosoma hijo1 = hijos.first;
-            Cromosoma hijo2 = hijos.second;
-
-            // Validar y mutar hijos
-            hijo1 = validarYMutar(hijo1, numeroCultivos, meses, cultivacion);
-            hijo2 = validarYMutar(hijo2, numeroCultivos, meses, cultivacion);
-
-            // Agregar hijos a la siguiente generación
-            siguienteGeneracion.agregarAPoblacion(hijo1);
-            siguienteGeneracion.agregarAPoblacion(hijo2);
-        }
+            pair<int, int> padres = seleccionarPadres(i, gen);
+            padresHijos[2 * i] = padres;
+            padresHijos[2 * i + 1] = padres;
+
+            // Realizar cruce en los cromosomas de trabajo de este hilo
+            VistaCromosoma hijo1 = borradoresCruce[2 * hilo].vista();
+            VistaCromosoma hijo2 = borradoresCruce[2 * hilo + 1].vista();
+            realizarCruce(poblacion[padres.first], poblacion[padres.second], numeroCultivos, meses, hijo1, hijo2, gen);
+
+            // Validar y mutar hijos directamente en su fila, cada pareja escribe en sus propias filas
+            validarYMutar(hijo1, numeroCultivos, meses, cultivacion, hijos[2 * i], arenas[hilo], gen);
+            validarYMutar(hijo2, numeroCultivos, meses, cultivacion, hijos[2 * i + 1], arenas[hilo], gen);
+        });
 
         // Combinar generaciones actual y siguiente
-        combinarGeneraciones(siguienteGeneracion, numeroCultivos, meses, cultivacion);
+        combinarGeneraciones(hijos, numeroCultivos, meses, cultivacion);
     }
 
     // Calcular el agua total requerida para todos los cultivos en un mes
-    double calcularAguaTotalRequerida(const Cromosoma& cromosoma, int numeroCultivos, int mes, double areaTotalDisponible,
+    double calcularAguaTotalRequerida(VistaConstCromosoma cromosoma, int numeroCultivos, int mes, double areaTotalDisponible,
                                       const vector<double>& requerimientoAgua) const {
         double aguaTotalRequerida = 0.0;
         for (int cultivo = 0; cultivo < numeroCultivos; ++cultivo) {
@@ -333,7 +550,7 @@ class Generacion {
     }
 
     // Calcular cosecha esperada y real para cada cultivo en un mes
-    double calcularCosechaCultivo(const Cromosoma& cromosoma, int numeroCultivos, int mes, double areaTotalDisponible,
+    double calcularCosechaCultivo(VistaConstCromosoma cromosoma, int numeroCultivos, int mes, double areaTotalDisponible,
                                   double coeficienteAgua, double conductividadElectrica,
                                   const vector<int>& mesesCultivo, const vector<double>& maxCosechaPorArea,
                                   const vector<double>& susceptibilidadAgua, const vector<double>& reduccionRendimiento,
@@ -364,7 +581,7 @@ class Generacion {
     }
 
     // Actualizar la salinidad para el siguiente mes
-    double actualizarSalinidad(const Cromosoma& cromosoma, int numeroCultivos, int mes, double areaTotalDisponible,
+    double actualizarSalinidad(VistaConstCromosoma cromosoma, int numeroCultivos, int mes, double areaTotalDisponible,
                                 const vector<double>& cambioSalinidadPorArea) const {
         double cambioTotalSalinidad = 0.0;
         for (int cultivo = 0; cultivo < numeroCultivos; ++cultivo) {
@@ -376,16 +593,16 @@ class Generacion {
     }
 
     // Transferir agua no utilizada al siguiente mes
-    void transferirAguaSobrante(vector<double>& aguaDisponible, int mes, double aguaTotalRequerida) const {
-        if (mes < aguaDisponible.size() - 1) {
+    void transferirAguaSobrante(Fila<double> aguaDisponible, int mes, double aguaTotalRequerida) const {
+        if (mes < static_cast<int>(aguaDisponible.size()) - 1) {
             aguaDisponible[mes + 1] += max(0.0, aguaDisponible[mes] - aguaTotalRequerida);
         }
     }
 
-    double funcionObjetivo(const Cromosoma& cromosoma, int numeroCultivos, int meses, Cultivacion& cultivacion) {
+    double funcionObjetivo(VistaConstCromosoma cromosoma, int numeroCultivos, int meses, Cultivacion& cultivacion, ArenaTrabajo& arena) {
         double cosechaTotal = 0.0;
         double conductividadElectrica = cultivacion.conductividadElectrica;
-        vector<double> aguaDisponible = cultivacion.aguaInicialDisponible;
+        Fila<double> aguaDisponible = arena.copiar(cultivacion.aguaInicialDisponible);
 
         for (int mes = 0; mes < meses; ++mes) {
             // Calcular el agua total requerida
@@ -415,33 +632,144 @@ class Generacion {
         return cosechaTotal;
     }
 
-    void actualizarValorObjetivo(size_t indice, int numeroCultivos, int meses, Cultivacion& cultivacion) {
-        double valor = funcionObjetivo(poblacion[indice], numeroCultivos, meses, cultivacion);
-        poblacion[indice].valorObjetivo = valor;  // Actualizar el valor objetivo del cromosoma
-        valoresObjetivo[indice] = valor;          // Actualizar el vector de valores objetivo
+    void actualizarValorObjetivo(int indice, int numeroCultivos, int meses, Cultivacion& cultivacion) {
+        prepararArenas();
+        arenas[0].reiniciar();
+        poblacion.valoresObjetivo[indice] = funcionObjetivo(poblacion[indice], numeroCultivos, meses, cultivacion, arenas[0]);
     }
 
-    void inicializarValoresObjetivo(int numeroCultivos, int meses, Cultivacion& cultivacion) {
-        valoresObjetivo.resize(poblacion.size());
-        for (size_t i = 0; i < poblacion.size(); ++i) {
-            actualizarValorObjetivo(i, numeroCultivos, meses, cultivacion);
+    // Numero de meses iniciales en que los genes de dos cromosomas coinciden
+    static int mesesComunes(VistaConstCromosoma a, VistaConstCromosoma b, int numeroCultivos, int meses) {
+        for (int mes = 0; mes < meses; ++mes) {
+            for (int cultivo = 0; cultivo < numeroCultivos; ++cultivo) {
+                int indice = cultivo + numeroCultivos * mes;
+                if (a.genes[indice] != b.genes[indice]) return mes;
+            }
         }
+        return meses;
+    }
+
+    // Evaluar toda una poblacion con el nucleo por lotes; funcionObjetivo queda como referencia escalar.
+    // Si se dan los padres de cada fila, una fila igual a un padre toma su valor y sus estados, y las demas
+    // se reanudan desde el primer mes en que difieren del padre mas parecido (salinidad y agua solo avanzan).
+    // Una fila cuya cota superior no pasa de 'corte' no puede sobrevivir y se descarta con valor -infinito.
+    // Despues se consulta la cache por el contenido y solo las filas que faltan pasan por el nucleo
+    void evaluarPoblacion(Poblacion& evaluada, int numeroCultivos, int meses, Cultivacion& cultivacion,
+                          const Poblacion* padres = nullptr, const vector<pair<int, int> >* padresFila = nullptr,
+                          double corte = -numeric_limits<double>::infinity()) {
+        GA_MEDIR_FASE(FASE_EVALUACION);
+        evaluador.preparar(cultivacion, numeroCultivos, meses, numeroHilos());
+        evaluada.prepararEstados(meses);
+        int total = evaluada.size();
+        int dimension = evaluada.obtenerDimension();
+        uint64_t base = evaluador.constantes.huella;
+        bool reanudar = padres != nullptr && padres->obtenerMesesEstado() == meses;
+        bool acotar = corte > -numeric_limits<double>::infinity();
+        // El nucleo puede contraer productos y sumas en FMA y redondear distinto que la cota; el margen lo cubre
+        const double margenCota = 1.0 + 1e-9;
+        huellas.resize(total);
+        filaEnCache.resize(total);
+        filaDescartada.resize(total);
+        referenciaFila.assign(total, -1);
+        mesInicioFila.assign(total, 0);
+        ejecutarEnParalelo(total, [&](int i, int) {
+            filaDescartada[i] = 0;
+            if (reanudar) {
+                int candidatos[2] = {(*padresFila)[i].first, (*padresFila)[i].second};
+                for (int padre : candidatos) {
+                    if (!padres->estadoValido[padre]) continue;
+                    int comunes = mesesComunes(evaluada[i], (*padres)[padre], numeroCultivos, meses);
+                    if (comunes > mesInicioFila[i]) {
+                        referenciaFila[i] = padre;
+                        mesInicioFila[i] = comunes;
+                    }
+                }
+                if (mesInicioFila[i] == meses) {
+                    evaluada.valoresObjetivo[i] = padres->valoresObjetivo[referenciaFila[i]];
+                    evaluada.copiarEstados(i, *padres, referenciaFila[i]);
+                    filaEnCache[i] = 1;
+                    return;
+                }
+            }
+            // La cota parte de la cosecha que el padre ya acumulo en los meses comunes, que el nucleo reutilizaria
+            if (acotar) {
+                int mesInicio = mesInicioFila[i];
+                double cosechaComun = referenciaFila[i] >= 0 ? padres->estadosFila(referenciaFila[i])[mesInicio].cosechaAcumulada : 0.0;
+                double cota = cotaSuperiorCosecha(evaluada[i], evaluador.constantes, numeroCultivos, mesInicio, meses, cosechaComun);
+                if (cota * margenCota <= corte) {
+                    evaluada.valoresObjetivo[i] = -numeric_limits<double>::infinity();
+                    evaluada.estadoValido[i] = 0;
+                    filaDescartada[i] = 1;
+                    filaEnCache[i] = 0;
+                    return;
+                }
+            }
+            huellas[i] = calcularHuella(evaluada[i].genes.data(), dimension, base);
+            filaEnCache[i] = cacheAptitud.buscar(huellas[i], evaluada.valoresObjetivo[i]);
+            if (filaEnCache[i] && reanudar) evaluada.estadoValido[i] = 0;
+        }, 16);
+
+        // Pendientes ordenadas por el mes desde el que se reanudan, para que cada lote empiece lo mas tarde posible
+        filasPendientes.clear();
+        if (acotar) hijosAcotados += total;
+        for (int i = 0; i < total; ++i) {
+            if (filaDescartada[i]) ++hijosDescartados;
+            else if (!filaEnCache[i]) filasPendientes.push_back(i);
+            else if (mesInicioFila[i] == meses) mesesOmitidos += meses;
+        }
+        sort(filasPendientes.begin(), filasPendientes.end(), [&](int a, int b) {
+            return mesInicioFila[a] > mesInicioFila[b] || (mesInicioFila[a] == mesInicioFila[b] && a < b);
+        });
+        int pendientes = static_cast<int>(filasPendientes.size());
+        referenciasPendientes.resize(pendientes);
+        mesesPendientes.resize(pendientes);
+        for (int p = 0; p < pendientes; ++p) {
+            referenciasPendientes[p] = referenciaFila[filasPendientes[p]];
+            mesesPendientes[p] = mesInicioFila[filasPendientes[p]];
+        }
+
+        int lotes = (pendientes + CARRILES_LOTE - 1) / CARRILES_LOTE;
+        for (int lote = 0; lote < lotes; ++lote) {
+            int inicio = lote * CARRILES_LOTE;
+            int carriles = min(CARRILES_LOTE, pendientes - inicio);
+            int mesLote = mesesPendientes[inicio + carriles - 1];
+            mesesEvaluados += static_cast<uint64_t>(meses - mesLote) * carriles;
+            mesesOmitidos += static_cast<uint64_t>(mesLote) * carriles;
+        }
+        ejecutarEnParalelo(lotes, [&](int lote, int hilo) {
+            evaluador.evaluarLote(evaluada, filasPendientes, lote, numeroCultivos, meses, hilo,
+                                  reanudar ? padres : nullptr, &referenciasPendientes, &mesesPendientes);
+            int fin = min(pendientes, (lote + 1) * CARRILES_LOTE);
+            for (int p = lote * CARRILES_LOTE; p < fin; ++p) {
+                int i = filasPendientes[p];
+                cacheAptitud.guardar(huellas[i], evaluada.valoresObjetivo[i]);
+            }
+        }, 2);
+    }
+
+    void inicializarValoresObjetivo(int numeroCultivos, int meses, Cultivacion& cultivacion) {
+        evaluarPoblacion(poblacion, numeroCultivos, meses, cultivacion);
     }
 
     void imprimirPoblacion(int numeroCultivos, double areaTotalDisponible) const {
-        for (const Cromosoma& cromosoma : poblacion) {
-            cromosoma.imprimirCromosoma(numeroCultivos);
+        for (int i = 0; i < poblacion.size(); ++i) {
+            poblacion.extraer(i).imprimirCromosoma(numeroCultivos);
         }
     }
 
-    Cromosoma encontrarMejorCromosoma() const {
-        auto mejorCromosoma = poblacion[0];
-        for (const auto& cromosoma : poblacion) {
-            if (cromosoma.valorObjetivo > mejorCromosoma.valorObjetivo) {
-                mejorCromosoma = cromosoma;
+    // Fila del mejor individuo (la primera, si hay empate), sin copiarlo
+    int indiceMejor() const {
+        int indiceMejor = 0;
+        for (int i = 1; i < poblacion.size(); ++i) {
+            if (poblacion.valoresObjetivo[i] > poblacion.valoresObjetivo[indiceMejor]) {
+                indiceMejor = i;
             }
         }
-        return mejorCromosoma;
+        return indiceMejor;
+    }
+
+    Cromosoma encontrarMejorCromosoma() const {
+        return poblacion.extraer(indiceMejor());
     }
 };
 
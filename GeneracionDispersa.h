@@ -0,0 +1,440 @@
+#ifndef GENERACIONDISPERSA_H
+#define GENERACIONDISPERSA_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+#include "Aleatorio.h"
+#include "ArenaTrabajo.h"
+#include "Cromosoma.h"
+#include "Cultivacion.h"
+#include "Generacion.h"
+#include "Instrumentacion.h"
+#include "Muestreo.h"
+#include "PlanSiembra.h"
+#include "PoolHilos.h"
+#include "Seleccion.h"
+
+// El algoritmo genetico de Generacion sobre planes de siembra dispersos. Los operadores hacen lo mismo, con las
+// mismas distribuciones, pero recorren las siembras en lugar de las matrices: validar, mutar y evaluar un plan
+// cuesta O(siembras x periodo de crecimiento + meses) en lugar de O(cultivos x meses). Los flujos aleatorios se
+// reparten como en Generacion (uno por individuo o pareja), asi que el resultado no depende del numero de hilos,
+// pero no repite la corrida densa: la validacion solo baraja las siembras de cada mes. No usa la cache de
+// aptitud ni la evaluacion incremental; cada hijo se evalua en la misma tarea que lo produce
+class GeneracionDispersa {
+   public:
+    int tamanoPoblacion = 100;           // Tamano de la poblacion
+    double tasaMutacion = 0.05;          // Parametros del algoritmo genetico
+    double tasaCruce = 0.8;              // Parametros del algoritmo genetico
+    vector<PlanSiembra> poblacion;       // Planes de la poblacion
+    vector<double> valoresObjetivo;      // Valor objetivo de cada plan, contiguos para el operador de seleccion
+    vector<PlanSiembra> hijos;           // Hijos validados, mutados y evaluados, reutilizados en cada generacion
+    vector<PlanSiembra> borradoresCruce; // Dos planes de trabajo por hilo donde se escribe el cruce
+    vector<PlanSiembra> siguiente;       // Sobrevivientes mientras se arma la poblacion siguiente
+    vector<Candidato> candidatos;        // (valor objetivo, indice) de padres e hijos para elegir sobrevivientes
+    vector<ArenaTrabajo> arenas;         // Memoria de trabajo de los operadores, una por hilo
+    OperadorSeleccion seleccion;         // Como se eligen los padres de cada pareja
+    TipoMuestreo muestreo = MUESTREO_RECHAZO;  // Como se sortean las siembras al inicializar y al ajustar areas
+    PoolHilos* poolHilos = nullptr;      // Pool compartido (nullptr = secuencial)
+    uint64_t semilla = 0;                // Semilla base de todos los flujos aleatorios
+    unsigned long numeroGeneracion = 0;  // Contador de generaciones, distingue los flujos de cada generacion
+    uint64_t evaluaciones = 0;           // Planes evaluados desde el ultimo reinicio
+
+    // Volver a empezar conservando la memoria ya reservada
+    void reiniciar() {
+        poblacion.clear();
+        valoresObjetivo.clear();
+        numeroGeneracion = 0;
+        evaluaciones = 0;
+    }
+
+    // Agregar tamanoPoblacion planes iniciales, con los flujos de la generacion 0
+    void inicializarPlanes(int numeroCultivos, int meses, Cultivacion& cultivacion) {
+        const IndiceFactibilidad& factibilidad = cultivacion.prepararFactibilidad(numeroCultivos, meses);
+        prepararHilos();
+        int inicio = static_cast<int>(poblacion.size());
+        poblacion.resize(inicio + tamanoPoblacion);
+        ejecutarEnParalelo(tamanoPoblacion, [&](int k, int hilo) {
+            GA_MEDIR_FASE(FASE_INICIALIZACION);
+            GeneradorAleatorio gen = crearGenerador(0, k);
+            ArenaTrabajo& arena = arenas[hilo];
+            arena.reiniciar();
+            inicializarPlan(poblacion[inicio + k], numeroCultivos, meses, cultivacion, factibilidad, arena, gen);
+        });
+    }
+
+    // Como Cromosoma::inicializar, con los mismos sorteos, agregando cada siembra a la lista. Un area nula no
+    // agrega nada: en la forma densa solo borra cultivoPlantado, que la validacion de los hijos vuelve a leer.
+    // El muestreo constructivo se hace sobre una fila densa de la arena y se conservan sus siembras
+    void inicializarPlan(PlanSiembra& plan, int numeroCultivos, int meses, const Cultivacion& cultivacion,
+                         const IndiceFactibilidad& factibilidad, ArenaTrabajo& arena, GeneradorAleatorio& gen) {
+        if (muestreo == MUESTREO_CONSTRUCTIVO) {
+            size_t dimension = static_cast<size_t>(numeroCultivos) * meses;
+            VistaCromosoma fila(arena.reservar<TipoGen>(dimension), arena.reservar<TipoGen>(dimension));
+            MuestreoSiembra::inicializar(fila, numeroCultivos, meses, cultivacion.mesesCultivo, cultivacion.requerimientoAgua,
+                                         factibilidad, cultivacion.aguaInicialDisponible, cultivacion.areaTotalDisponible, arena, gen);
+            plan.desdeCromosoma(fila, numeroCultivos, meses);
+            return;
+        }
+
+        plan.limpiar();
+        Fila<double> areaDisponible = arena.reservar(meses, 1.0);
+        Fila<double> aguaDisponible = arena.copiar(cultivacion.aguaInicialDisponible);
+        chi_squared_distribution<> dist(5);
+        for (int mes = 0; mes < meses; ++mes) {
+            while (factibilidad.cultivosEnMes(mes) > 0 && Cromosoma::debeEntrarAlBucleDeInicializacion(areaDisponible[mes], gen)) {
+                int cultivo = gen.enteroMenorQue(numeroCultivos);
+                int periodoCrecimiento = cultivacion.mesesCultivo[cultivo];
+                if (!factibilidad.puedeSembrar(cultivo, mes)) {
+                    GA_CONTAR(RECHAZO_INICIALIZAR_CULTIVABLE);
+                    continue;
+                }
+
+                double prcAreaUsada = 8 * dist(gen) / 100.0;
+                double areaUsada = (prcAreaUsada > 1 ? 0.0 : prcAreaUsada) * areaDisponible[mes];
+                if (!Cromosoma::esAguaSuficiente(aguaDisponible, cultivacion.requerimientoAgua, cultivo, mes, periodoCrecimiento,
+                                                 areaUsada, cultivacion.areaTotalDisponible, gen)) {
+                    GA_CONTAR(RECHAZO_INICIALIZAR_AGUA);
+                    continue;
+                }
+
+                descontarSiembra(cultivo, mes, meses, areaUsada, cultivacion, areaDisponible, aguaDisponible);
+                if (areaUsada > 0.0) plan.agregar(cultivo, mes, areaUsada);
+            }
+
+            // Transferir agua no usada al siguiente mes
+            if (mes < meses - 1) {
+                aguaDisponible[mes + 1] += aguaDisponible[mes];
+            }
+        }
+    }
+
+    // Descontar el area y el agua que usa una siembra en los meses de su periodo de crecimiento
+    static void descontarSiembra(int cultivo, int mes, int meses, double areaUsada, const Cultivacion& cultivacion,
+                                 Fila<double> areaDisponible, Fila<double> aguaDisponible) {
+        double aguaRequerida = cultivacion.requerimientoAgua[cultivo] * (areaUsada * cultivacion.areaTotalDisponible);
+        for (int m = 0; m < cultivacion.mesesCultivo[cultivo] && (mes + m) < meses; ++m) {
+            areaDisponible[mes + m] -= areaUsada;
+            aguaDisponible[mes + m] -= min(aguaDisponible[mes + m], aguaRequerida);
+        }
+    }
+
+    // Cruce de un punto por mes, como Generacion::realizarCruce: hijo1 toma las siembras de padre1 anteriores al
+    // punto y las de padre2 desde el punto (hijo2 al reves)
+    void realizarCruce(const PlanSiembra& padre1, const PlanSiembra& padre2, int meses, PlanSiembra& hijo1, PlanSiembra& hijo2,
+                       GeneradorAleatorio& gen) {
+        GA_MEDIR_FASE(FASE_CRUCE);
+        int puntoCruce = meses;  // Sin cruce los hijos son copias de los padres
+        if (gen.uniforme() < tasaCruce) {
+            uniform_int_distribution<> distMes(0, meses - 1);
+            puntoCruce = distMes(gen);
+        }
+
+        int corte1 = padre1.primeraDesde(puntoCruce);
+        int corte2 = padre2.primeraDesde(puntoCruce);
+        hijo1.eventos.assign(padre1.eventos.begin(), padre1.eventos.begin() + corte1);
+        hijo1.eventos.insert(hijo1.eventos.end(), padre2.eventos.begin() + corte2, padre2.eventos.end());
+        hijo2.eventos.assign(padre2.eventos.begin(), padre2.eventos.begin() + corte2);
+        hijo2.eventos.insert(hijo2.eventos.end(), padre1.eventos.begin() + corte1, padre1.eventos.end());
+    }
+
+    // Como Generacion::validarHijo: en cada mes, en orden al azar, cada siembra se recorta al area que queda libre.
+    // Se barajan solo las siembras del mes, que es el orden que inducen sobre ellas todos los cultivos barajados
+    void validarPlan(const PlanSiembra& hijo, int meses, const Cultivacion& cultivacion, PlanSiembra& validado,
+                     ArenaTrabajo& arena, GeneradorAleatorio& gen) {
+        GA_MEDIR_FASE(FASE_VALIDACION);
+        validado.limpiar();
+        Fila<double> areaDisponible = arena.reservar(meses, 1.0);
+        Fila<int> orden = arena.reservar<int>(hijo.size());
+
+        for (int inicio = 0, fin = 0; inicio < hijo.size(); inicio = fin) {
+            int mes = hijo.eventos[inicio].mes;
+            while (fin < hijo.size() && hijo.eventos[fin].mes == mes) ++fin;
+            for (int k = inicio; k < fin; ++k) orden[k] = k;
+            for (int k = fin - 1; k > inicio; --k) swap(orden[k], orden[inicio + gen.enteroMenorQue(k - inicio + 1)]);
+
+            for (int k = inicio; k < fin; ++k) {
+                const EventoSiembra& evento = hijo.eventos[orden[k]];
+                if (evento.area <= 0.0) continue;
+                double areaAsignada = Generacion::ajustarAreaAsignada(evento.area, areaDisponible[mes], muestreo, gen);
+                if (areaAsignada == 0.0) continue;
+                for (int m = 0; m < cultivacion.mesesCultivo[evento.cultivo] && (mes + m) < meses; ++m) {
+                    areaDisponible[mes + m] -= areaAsignada;
+                }
+                validado.agregar(evento.cultivo, mes, areaAsignada);
+            }
+        }
+    }
+
+    // Como Generacion::mutarCromosoma: reducir entre 1% y 10% una siembra al azar y volver a sembrar donde quepa
+    void mutarPlan(PlanSiembra& plan, int numeroCultivos, int meses, Cultivacion& cultivacion, ArenaTrabajo& arena,
+                   GeneradorAleatorio& gen) {
+        GA_MEDIR_FASE(FASE_MUTACION);
+        int positivas = 0;
+        for (const EventoSiembra& evento : plan.eventos) {
+            if (evento.area > 0.0) ++positivas;
+        }
+        if (positivas == 0) return;  // No es posible mutar
+
+        uniform_int_distribution<> indiceAleatorio(0, positivas - 1);
+        int elegida = indiceAleatorio(gen);
+        for (EventoSiembra& evento : plan.eventos) {
+            if (evento.area > 0.0 && elegida-- == 0) {
+                uniform_real_distribution<> reduccionAleatoria(0.01, 0.1);
+                evento.area -= evento.area * reduccionAleatoria(gen);
+                break;
+            }
+        }
+
+        reinicializarPlan(plan, numeroCultivos, meses, cultivacion, arena, gen);
+    }
+
+    // Como Generacion::reinicializarCromosoma: a lo sumo una siembra nueva por mes. El area libre de cada mes
+    // se calcula una vez con las siembras del plan y se descuenta al sembrar, en lugar de volver a sumar la
+    // matriz en cada mes; el agua parte de la inicial. Las siembras nuevas se mezclan al final por mes
+    void reinicializarPlan(PlanSiembra& plan, int numeroCultivos, int meses, Cultivacion& cultivacion, ArenaTrabajo& arena,
+                           GeneradorAleatorio& gen) {
+        GA_MEDIR_FASE(FASE_REINICIALIZACION);
+        Fila<double> areaDisponible = arena.reservar(meses, 1.0);
+        Fila<double> aguaDisponible = arena.copiar(cultivacion.aguaInicialDisponible);
+        for (const EventoSiembra& evento : plan.eventos) {
+            for (int m = 0; m < cultivacion.mesesCultivo[evento.cultivo] && (evento.mes + m) < meses; ++m) {
+                areaDisponible[evento.mes + m] -= evento.area;
+            }
+        }
+
+        Fila<EventoSiembra> nuevas = arena.reservar<EventoSiembra>(meses);
+        int numeroNuevas = 0;
+        chi_squared_distribution<> dist(5);
+        for (int mes = 0; mes < meses; ++mes) {
+            if (!Cromosoma::debeEntrarAlBucleDeInicializacion(areaDisponible[mes], gen)) continue;
+            int cultivo = gen.enteroMenorQue(numeroCultivos);
+            int periodoCrecimiento = cultivacion.mesesCultivo[cultivo];
+            if (!cultivacion.factibilidad.puedeSembrar(cultivo, mes)) {
+                GA_CONTAR(RECHAZO_REINICIALIZAR_CULTIVABLE);
+                continue;
+            }
+
+            double areaMinimaDisponible = areaDisponible[mes];
+            for (int m = 1; m < periodoCrecimiento && (mes + m) < meses; ++m) {
+                areaMinimaDisponible = min(areaMinimaDisponible, areaDisponible[mes + m]);
+            }
+            double prcAreaUsada = 8 * dist(gen) / 100.0;
+            double areaUsada = (prcAreaUsada > 1 ? 0.0 : prcAreaUsada) * areaMinimaDisponible;
+            if (!Cromosoma::esAguaSuficiente(aguaDisponible, cultivacion.requerimientoAgua, cultivo, mes, periodoCrecimiento,
+                                             areaUsada, cultivacion.areaTotalDisponible, gen)) {
+                GA_CONTAR(RECHAZO_REINICIALIZAR_AGUA);
+                continue;
+            }
+
+            descontarSiembra(cultivo, mes, meses, areaUsada, cultivacion, areaDisponible, aguaDisponible);
+            if (areaUsada != 0.0) {
+                EventoSiembra evento = {cultivo, mes, areaUsada};
+                nuevas[numeroNuevas++] = evento;
+            }
+        }
+        if (numeroNuevas == 0) return;
+
+        // Mezclar por mes; en un mismo mes, las siembras que ya estaban van primero
+        Fila<EventoSiembra> anteriores = arena.copiar(plan.eventos);
+        plan.eventos.clear();
+        size_t a = 0;
+        for (int n = 0; n < numeroNuevas; ++n) {
+            while (a < anteriores.size() && anteriores[a].mes <= nuevas[n].mes) plan.eventos.push_back(anteriores[a++]);
+            plan.eventos.push_back(nuevas[n]);
+        }
+        plan.eventos.insert(plan.eventos.end(), anteriores.begin() + a, anteriores.end());
+    }
+
+    // Validar el hijo, mutarlo y evaluarlo, con la arena reiniciada una vez por hijo
+    void validarYMutar(const PlanSiembra& hijo, int numeroCultivos, int meses, Cultivacion& cultivacion, PlanSiembra& hijoValidado,
+                       ArenaTrabajo& arena, GeneradorAleatorio& gen) {
+        arena.reiniciar();
+        validarPlan(hijo, meses, cultivacion, hijoValidado, arena, gen);
+        if (gen.uniforme() < tasaMutacion) {
+            mutarPlan(hijoValidado, numeroCultivos, meses, cultivacion, arena, gen);
+        }
+        hijoValidado.valorObjetivo = evaluarPlan(hijoValidado, numeroCultivos, meses, cultivacion, arena);
+    }
+
+    // La funcion objetivo de Generacion::funcionObjetivo sobre las siembras. Cada mes se actualiza la lista de
+    // siembras activas (las que empezaron y no han cumplido su periodo), se suman sus areas por cultivo y los
+    // cultivos tocados se recorren en orden, como en la forma densa; los demas cultivos no aportan
+    double evaluarPlan(const PlanSiembra& plan, int numeroCultivos, int meses, const Cultivacion& cultivacion, ArenaTrabajo& arena) const {
+        GA_MEDIR_FASE(FASE_EVALUACION);
+        Fila<double> areaCultivo = arena.reservar(numeroCultivos, 0.0);
+        Fila<char> enLista = arena.reservar(numeroCultivos, static_cast<char>(0));
+        Fila<int> tocados = arena.reservar<int>(numeroCultivos);
+        Fila<int> activas = arena.reservar<int>(plan.size());
+        Fila<double> aguaDisponible = arena.copiar(cultivacion.aguaInicialDisponible);
+        double areaTotal = cultivacion.areaTotalDisponible;
+        double conductividadElectrica = cultivacion.conductividadElectrica;
+        double cosechaTotal = 0.0;
+        int numeroActivas = 0, siguienteSiembra = 0;
+
+        for (int mes = 0; mes < meses; ++mes) {
+            int quedan = 0;
+            for (int k = 0; k < numeroActivas; ++k) {
+                const EventoSiembra& evento = plan.eventos[activas[k]];
+                if (evento.mes + cultivacion.mesesCultivo[evento.cultivo] > mes) activas[quedan++] = activas[k];
+            }
+            numeroActivas = quedan;
+            while (siguienteSiembra < plan.size() && plan.eventos[siguienteSiembra].mes == mes) activas[numeroActivas++] = siguienteSiembra++;
+
+            int numeroTocados = 0;
+            for (int k = 0; k < numeroActivas; ++k) {
+                const EventoSiembra& evento = plan.eventos[activas[k]];
+                if (!enLista[evento.cultivo]) {
+                    enLista[evento.cultivo] = 1;
+                    tocados[numeroTocados++] = evento.cultivo;
+                }
+                areaCultivo[evento.cultivo] += evento.area;
+            }
+            sort(tocados.begin(), tocados.begin() + numeroTocados);
+
+            double aguaTotalRequerida = 0.0;
+            for (int k = 0; k < numeroTocados; ++k) {
+                int cultivo = tocados[k];
+                if (areaCultivo[cultivo] > 0) aguaTotalRequerida += cultivacion.requerimientoAgua[cultivo] * areaCultivo[cultivo] * areaTotal;
+            }
+            double coeficienteAgua = aguaTotalRequerida > 0 ? min(1.0, max(0.0, aguaDisponible[mes] / aguaTotalRequerida)) : 1.0;
+
+            double cambioSalinidad = 0.0;
+            for (int k = 0; k < numeroTocados; ++k) {
+                int cultivo = tocados[k];
+                double areaAsignada = areaCultivo[cultivo];
+                cambioSalinidad += cultivacion.cambioSalinidadPorArea[cultivo] * (areaAsignada * areaTotal);
+                areaCultivo[cultivo] = 0.0;
+                enLista[cultivo] = 0;
+                if (areaAsignada <= 0) continue;
+
+                double cosechaEsperada = (cultivacion.maxCosechaPorArea[cultivo] * areaAsignada) / cultivacion.mesesCultivo[cultivo];
+                double efectoAgua = 1 - exp(-(coeficienteAgua * cultivacion.susceptibilidadAgua[cultivo]) / areaAsignada);
+                double impactoSalinidad = cultivacion.reduccionRendimiento[cultivo] * (conductividadElectrica - cultivacion.salinidadCritica[cultivo]);
+                double efectoSalinidad = min(1.0, max(0.0, 1.0 - impactoSalinidad / 100.0));
+                cosechaTotal += cosechaEsperada * efectoAgua * efectoSalinidad;
+            }
+
+            if (mes < meses - 1) {
+                conductividadElectrica += cambioSalinidad;
+                aguaDisponible[mes + 1] += max(0.0, aguaDisponible[mes] - aguaTotalRequerida);
+            }
+        }
+        return cosechaTotal;
+    }
+
+    // Evaluar toda la poblacion y dejar sus valores listos para la seleccion
+    void inicializarValoresObjetivo(int numeroCultivos, int meses, Cultivacion& cultivacion) {
+        prepararHilos();
+        ejecutarEnParalelo(static_cast<int>(poblacion.size()), [&](int i, int hilo) {
+            arenas[hilo].reiniciar();
+            poblacion[i].valorObjetivo = evaluarPlan(poblacion[i], numeroCultivos, meses, cultivacion, arenas[hilo]);
+        }, 16);
+        evaluaciones += poblacion.size();
+        copiarValoresObjetivo();
+    }
+
+    void obtenerNuevaGeneracion(int tamanoPoblacion, int numeroCultivos, int meses, Cultivacion& cultivacion) {
+        int parejas = tamanoPoblacion / 2;
+        prepararHilos();
+        hijos.resize(2 * parejas);
+        cultivacion.prepararFactibilidad(numeroCultivos, meses);  // Antes de repartir parejas entre hilos
+        ++numeroGeneracion;
+
+        {
+            GA_MEDIR_FASE(FASE_SELECCION);
+            seleccion.preparar(valoresObjetivo.data(), tamanoPoblacion, parejas, crearGenerador(numeroGeneracion, -1));
+        }
+
+        ejecutarEnParalelo(parejas, [&](int i, int hilo) {
+            GeneradorAleatorio gen = crearGenerador(numeroGeneracion, i);
+            pair<int, int> padres;
+            {
+                GA_MEDIR_FASE(FASE_SELECCION);
+                padres = seleccion.elegirPadres(i, gen);
+            }
+            PlanSiembra& hijo1 = borradoresCruce[2 * hilo];
+            PlanSiembra& hijo2 = borradoresCruce[2 * hilo + 1];
+            realizarCruce(poblacion[padres.first], poblacion[padres.second], meses, hijo1, hijo2, gen);
+            validarYMutar(hijo1, numeroCultivos, meses, cultivacion, hijos[2 * i], arenas[hilo], gen);
+            validarYMutar(hijo2, numeroCultivos, meses, cultivacion, hijos[2 * i + 1], arenas[hilo], gen);
+        });
+        evaluaciones += hijos.size();
+
+        combinarGeneraciones();
+    }
+
+    // Quedarse con los tamanoPoblacion mejores entre padres e hijos, con el mismo orden que Generacion. Los
+    // planes se copian sobre los de la poblacion anterior, que reutilizan su memoria
+    void combinarGeneraciones() {
+        GA_MEDIR_FASE(FASE_COMBINACION);
+        int tamanoActual = static_cast<int>(poblacion.size());
+        int tamanoCombinado = tamanoActual + static_cast<int>(hijos.size());
+        candidatos.resize(tamanoCombinado);
+        for (int i = 0; i < tamanoCombinado; ++i) {
+            candidatos[i].valor = i < tamanoActual ? poblacion[i].valorObjetivo : hijos[i - tamanoActual].valorObjetivo;
+            candidatos[i].indice = i;
+        }
+
+        int sobrevivientes = min(tamanoPoblacion, tamanoCombinado);
+        if (sobrevivientes < tamanoCombinado) {
+            nth_element(candidatos.begin(), candidatos.begin() + sobrevivientes, candidatos.end(), mejorCandidato);
+        }
+        sort(candidatos.begin(), candidatos.begin() + sobrevivientes, mejorCandidato);
+
+        siguiente.resize(sobrevivientes);
+        for (int r = 0; r < sobrevivientes; ++r) {
+            int origen = candidatos[r].indice;
+            siguiente[r] = origen < tamanoActual ? poblacion[origen] : hijos[origen - tamanoActual];
+        }
+        poblacion.swap(siguiente);
+        copiarValoresObjetivo();
+    }
+
+    // Plan de la fila 'indice' como cromosoma denso, para informar el resultado
+    Cromosoma extraer(int indice, int numeroCultivos, int meses, const vector<int>& mesesCultivo) const {
+        Cromosoma cromosoma(numeroCultivos * meses);
+        poblacion[indice].expandir(cromosoma.vista(), numeroCultivos, meses, mesesCultivo);
+        cromosoma.valorObjetivo = poblacion[indice].valorObjetivo;
+        return cromosoma;
+    }
+
+    // Ejecutar tarea(indice, hilo) para cada indice, en el pool si existe o en este hilo si no
+    template <class Tarea>
+    void ejecutarEnParalelo(int total, const Tarea& tarea, int tamanoBloque = 1) {
+        if (poolHilos != nullptr) {
+            poolHilos->paraCada(total, tarea, tamanoBloque);
+        } else {
+            for (int i = 0; i < total; ++i) tarea(i, 0);
+        }
+    }
+
+    int numeroHilos() const {
+        return poolHilos != nullptr ? poolHilos->numeroHilos() : 1;
+    }
+
+    // Los mismos flujos que Generacion::crearGenerador
+    GeneradorAleatorio crearGenerador(unsigned long generacion, int tarea) const {
+        return GeneradorAleatorio(semilla, (static_cast<uint64_t>(generacion) << 32) | static_cast<uint32_t>(tarea));
+    }
+
+   private:
+    // Arenas y planes de cruce de cada hilo; los que ya existen conservan su memoria
+    void prepararHilos() {
+        if (static_cast<int>(arenas.size()) < numeroHilos()) arenas.resize(numeroHilos());
+        if (static_cast<int>(borradoresCruce.size()) < 2 * numeroHilos()) borradoresCruce.resize(2 * numeroHilos());
+    }
+
+    void copiarValoresObjetivo() {
+        valoresObjetivo.resize(poblacion.size());
+        for (size_t i = 0; i < poblacion.size(); ++i) valoresObjetivo[i] = poblacion[i].valorObjetivo;
+    }
+};
+
+#endif /* GENERACIONDISPERSA_H */
@@ -0,0 +1,317 @@
+#ifndef INSTRUMENTACION_H
+#define INSTRUMENTACION_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Instrumentacion de las fases de cada generacion: tiempo y llamadas por fase, rechazos de los bucles de
+// inicializacion y asignaciones de memoria, con un reporte por generacion (CSV o JSON) y una traza de eventos
+// para chrome://tracing. Se activa al compilar con -DGA_INSTRUMENTACION, por ejemplo
+//     make CONF=Release CXXFLAGS=-DGA_INSTRUMENTACION
+// Sin esa bandera las macros no generan codigo y la clase no hace nada
+
+enum Fase {
+    FASE_INICIALIZACION,    // Cromosoma::inicializar de la poblacion inicial
+    FASE_SELECCION,         // seleccionarPadres
+    FASE_CRUCE,             // realizarCruce
+    FASE_VALIDACION,        // validarHijo
+    FASE_MUTACION,          // mutarCromosoma, incluye su reinicializacion
+    FASE_REINICIALIZACION,  // reinicializarCromosoma
+    FASE_EVALUACION,        // evaluarPoblacion (cache, reanudacion y nucleo por lotes)
+    FASE_COMBINACION,       // Seleccion y compactacion de sobrevivientes
+    NUMERO_FASES
+};
+
+enum Contador {
+    RECHAZO_INICIALIZAR_CULTIVABLE,    // Cultivo sorteado que no se puede cultivar en Cromosoma::inicializar
+    RECHAZO_INICIALIZAR_AGUA,          // Area sorteada sin agua suficiente en Cromosoma::inicializar
+    RECHAZO_REINICIALIZAR_CULTIVABLE,  // Lo mismo en reinicializarCromosoma
+    RECHAZO_REINICIALIZAR_AGUA,
+    NUMERO_CONTADORES
+};
+
+static const char* const NOMBRES_FASES[NUMERO_FASES] = {
+    "inicializacion", "seleccion", "cruce", "validacion", "mutacion", "reinicializacion", "evaluacion", "combinacion"};
+
+static const char* const NOMBRES_CONTADORES[NUMERO_CONTADORES] = {
+    "rechazos_inicializar_cultivable", "rechazos_inicializar_agua", "rechazos_reinicializar_cultivable",
+    "rechazos_reinicializar_agua"};
+
+#ifdef GA_INSTRUMENTACION
+
+#define GA_CONCATENAR_(a, b) a##b
+#define GA_CONCATENAR(a, b) GA_CONCATENAR_(a, b)
+// Medir el resto del bloque actual como la fase indicada
+#define GA_MEDIR_FASE(fase) MedidorFase GA_CONCATENAR(medidorFase, __LINE__)(fase)
+#define GA_CONTAR(contador) Instrumentacion::global().hiloActual().contar(contador)
+
+// Asignaciones de todo el programa; las cuenta el operator new que define GA_CONTAR_ASIGNACIONES
+inline atomic<uint64_t>& contadorAsignaciones() {
+    static atomic<uint64_t> asignaciones(0);
+    return asignaciones;
+}
+
+inline atomic<uint64_t>& contadorBytesAsignados() {
+    static atomic<uint64_t> bytes(0);
+    return bytes;
+}
+
+#if defined(__GNUC__)
+#define GA_SIN_EXPANDIR __attribute__((noinline))
+#else
+#define GA_SIN_EXPANDIR
+#endif
+
+// Reemplazo de operator new que cuenta cada asignacion. Debe usarse una sola vez, en el archivo de main.
+// Los delete no se expanden en quien los llama: si GCC ve el free() junto a un operator new, avisa con
+// -Wmismatched-new-delete aunque los dos sean los reemplazos de aqui y usen malloc y free
+#define GA_CONTAR_ASIGNACIONES()                                                              \
+    void* operator new(size_t tamano) {                                                       \
+        contadorAsignaciones().fetch_add(1, memory_order_relaxed);                            \
+        contadorBytesAsignados().fetch_add(tamano, memory_order_relaxed);                     \
+        void* p = malloc(tamano > 0 ? tamano : 1);                                            \
+        if (p == nullptr) throw bad_alloc();                                                  \
+        return p;                                                                             \
+    }                                                                                         \
+    void* operator new[](size_t tamano) { return operator new(tamano); }                      \
+    GA_SIN_EXPANDIR void operator delete(void* p) noexcept { free(p); }                       \
+    GA_SIN_EXPANDIR void operator delete[](void* p) noexcept { free(p); }                     \
+    GA_SIN_EXPANDIR void operator delete(void* p, size_t) noexcept { free(p); }               \
+    GA_SIN_EXPANDIR void operator delete[](void* p, size_t) noexcept { free(p); }
+
+struct EventoTraza {
+    Fase fase;
+    uint64_t inicio;    // Nanosegundos desde el inicio de la instrumentacion
+    uint64_t duracion;  // Nanosegundos
+};
+
+// Acumuladores de un hilo. Solo ese hilo los incrementa; se leen y reinician al cerrar cada generacion,
+// cuando el pool esta detenido
+struct RegistroHilo {
+    static const size_t CAPACIDAD_EVENTOS = 1 << 14;  // Eventos de traza por hilo y generacion
+
+    int id;
+    atomic<uint64_t> nanosegundos[NUMERO_FASES];
+    atomic<uint64_t> llamadas[NUMERO_FASES];
+    atomic<uint64_t> contadores[NUMERO_CONTADORES];
+    vector<EventoTraza> eventos;
+    uint64_t eventosDescartados;
+
+    explicit RegistroHilo(int id) : id(id), eventosDescartados(0) {
+        for (int f = 0; f < NUMERO_FASES; ++f) {
+            nanosegundos[f].store(0);
+            llamadas[f].store(0);
+        }
+        for (int c = 0; c < NUMERO_CONTADORES; ++c) contadores[c].store(0);
+        eventos.reserve(CAPACIDAD_EVENTOS);
+    }
+
+    void contar(Contador contador) {
+        contadores[contador].fetch_add(1, memory_order_relaxed);
+    }
+
+    void registrar(Fase fase, uint64_t inicio, uint64_t duracion, bool conTraza) {
+        nanosegundos[fase].fetch_add(duracion, memory_order_relaxed);
+        llamadas[fase].fetch_add(1, memory_order_relaxed);
+        if (!conTraza) return;
+        if (eventos.size() < CAPACIDAD_EVENTOS) {
+            EventoTraza evento = {fase, inicio, duracion};
+            eventos.push_back(evento);
+        } else {
+            ++eventosDescartados;
+        }
+    }
+};
+
+class Instrumentacion {
+   public:
+    static const bool ACTIVA = true;
+
+    static Instrumentacion& global() {
+        static Instrumentacion instancia;
+        return instancia;
+    }
+
+    ~Instrumentacion() {
+        finalizar();
+        for (RegistroHilo* registro : registros) delete registro;
+    }
+
+    // Reporte por generacion: JSON si la ruta termina en .json, CSV en otro caso
+    bool abrirReporte(const string& ruta) {
+        reporteJson = ruta.size() >= 5 && ruta.compare(ruta.size() - 5, 5, ".json") == 0;
+        reporte.open(ruta.c_str());
+        if (!reporte) return false;
+        if (reporteJson) {
+            reporte << "[\n";
+        } else {
+            reporte << "generacion";
+            for (int f = 0; f < NUMERO_FASES; ++f) reporte << "," << NOMBRES_FASES[f] << "_ms," << NOMBRES_FASES[f] << "_llamadas";
+            for (int c = 0; c < NUMERO_CONTADORES; ++c) reporte << "," << NOMBRES_CONTADORES[c];
+            reporte << ",asignaciones,bytes_asignados,eventos_descartados\n";
+        }
+        return true;
+    }
+
+    // Traza en el formato de eventos de Chrome (chrome://tracing, Perfetto)
+    bool abrirTraza(const string& ruta) {
+        traza.open(ruta.c_str());
+        if (!traza) return false;
+        traza << "{\"traceEvents\":[\n";
+        eventosEscritos = 0;
+        return true;
+    }
+
+    RegistroHilo& hiloActual() {
+        static thread_local RegistroHilo* registro = nullptr;
+        if (registro == nullptr) {
+            lock_guard<mutex> bloqueo(mutexRegistros);
+            registro = new RegistroHilo(static_cast<int>(registros.size()));
+            registros.push_back(registro);
+        }
+        return *registro;
+    }
+
+    uint64_t ahora() const {
+        return static_cast<uint64_t>(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - origen).count());
+    }
+
+    bool conTraza() const {
+        return traza.is_open();
+    }
+
+    // Escribir la fila de la generacion con lo acumulado desde la anterior y vaciar los eventos de traza.
+    // Se llama entre generaciones, sin tareas del pool en curso
+    void cerrarGeneracion(unsigned long generacion) {
+        lock_guard<mutex> bloqueo(mutexRegistros);
+        uint64_t nanosegundos[NUMERO_FASES] = {}, llamadas[NUMERO_FASES] = {}, contadores[NUMERO_CONTADORES] = {};
+        uint64_t descartados = 0;
+        for (RegistroHilo* registro : registros) {
+            for (int f = 0; f < NUMERO_FASES; ++f) {
+                nanosegundos[f] += registro->nanosegundos[f].exchange(0);
+                llamadas[f] += registro->llamadas[f].exchange(0);
+            }
+            for (int c = 0; c < NUMERO_CONTADORES; ++c) contadores[c] += registro->contadores[c].exchange(0);
+            descartados += registro->eventosDescartados;
+            registro->eventosDescartados = 0;
+            escribirEventos(*registro, generacion);
+        }
+        uint64_t asignaciones = contadorAsignaciones().load();
+        uint64_t bytes = contadorBytesAsignados().load();
+        uint64_t asignacionesGeneracion = asignaciones - asignacionesPrevias;
+        uint64_t bytesGeneracion = bytes - bytesPrevios;
+        asignacionesPrevias = asignaciones;
+        bytesPrevios = bytes;
+
+        if (!reporte.is_open()) return;
+        if (reporteJson) {
+            reporte << (filasEscritas > 0 ? ",\n" : "") << "  {\"generacion\": " << generacion;
+            for (int f = 0; f < NUMERO_FASES; ++f) {
+                reporte << ", \"" << NOMBRES_FASES[f] << "_ms\": " << nanosegundos[f] / 1e6
+                        << ", \"" << NOMBRES_FASES[f] << "_llamadas\": " << llamadas[f];
+            }
+            for (int c = 0; c < NUMERO_CONTADORES; ++c) reporte << ", \"" << NOMBRES_CONTADORES[c] << "\": " << contadores[c];
+            reporte << ", \"asignaciones\": " << asignacionesGeneracion << ", \"bytes_asignados\": " << bytesGeneracion
+                    << ", \"eventos_descartados\": " << descartados << "}";
+        } else {
+            reporte << generacion;
+            for (int f = 0; f < NUMERO_FASES; ++f) reporte << "," << nanosegundos[f] / 1e6 << "," << llamadas[f];
+            for (int c = 0; c < NUMERO_CONTADORES; ++c) reporte << "," << contadores[c];
+            reporte << "," << asignacionesGeneracion << "," << bytesGeneracion << "," << descartados << "\n";
+        }
+        ++filasEscritas;
+    }
+
+    // Cerrar los archivos dejando JSON valido
+    void finalizar() {
+        if (reporte.is_open()) {
+            if (reporteJson) reporte << "\n]\n";
+            reporte.close();
+        }
+        if (traza.is_open()) {
+            lock_guard<mutex> bloqueo(mutexRegistros);
+            for (RegistroHilo* registro : registros) {
+                traza << (eventosEscritos++ > 0 ? ",\n" : "") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+                      << registro->id << ",\"args\":{\"name\":\"hilo " << registro->id << "\"}}";
+            }
+            traza << "\n]}\n";
+            traza.close();
+        }
+    }
+
+   private:
+    chrono::steady_clock::time_point origen;
+    mutex mutexRegistros;
+    vector<RegistroHilo*> registros;
+    ofstream reporte;
+    ofstream traza;
+    bool reporteJson = false;
+    unsigned long filasEscritas = 0;
+    unsigned long eventosEscritos = 0;
+    uint64_t asignacionesPrevias = 0;
+    uint64_t bytesPrevios = 0;
+
+    Instrumentacion() : origen(chrono::steady_clock::now()) {}
+
+    void escribirEventos(RegistroHilo& registro, unsigned long generacion) {
+        if (traza.is_open()) {
+            for (const EventoTraza& evento : registro.eventos) {
+                traza << (eventosEscritos++ > 0 ? ",\n" : "") << "{\"name\":\"" << NOMBRES_FASES[evento.fase]
+                      << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << registro.id << ",\"ts\":" << evento.inicio / 1000.0
+                      << ",\"dur\":" << evento.duracion / 1000.0 << ",\"args\":{\"generacion\":" << generacion << "}}";
+            }
+        }
+        registro.eventos.clear();
+    }
+};
+
+// Mide desde su construccion hasta el final del bloque y lo acumula en el registro del hilo
+class MedidorFase {
+   public:
+    explicit MedidorFase(Fase fase) : fase(fase), inicio(Instrumentacion::global().ahora()) {}
+
+    ~MedidorFase() {
+        Instrumentacion& instrumentacion = Instrumentacion::global();
+        uint64_t fin = instrumentacion.ahora();
+        instrumentacion.hiloActual().registrar(fase, inicio, fin - inicio, instrumentacion.conTraza());
+    }
+
+   private:
+    Fase fase;
+    uint64_t inicio;
+};
+
+#else
+
+#define GA_MEDIR_FASE(fase) ((void)0)
+#define GA_CONTAR(contador) ((void)0)
+#define GA_CONTAR_ASIGNACIONES()
+
+// Sin instrumentacion: la misma interfaz, sin efecto
+class Instrumentacion {
+   public:
+    static const bool ACTIVA = false;
+
+    static Instrumentacion& global() {
+        static Instrumentacion instancia;
+        return instancia;
+    }
+
+    bool abrirReporte(const string&) { return false; }
+    bool abrirTraza(const string&) { return false; }
+    void cerrarGeneracion(unsigned long) {}
+    void finalizar() {}
+};
+
+#endif /* GA_INSTRUMENTACION */
+
+#endif /* INSTRUMENTACION_H */
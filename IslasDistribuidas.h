@@ -0,0 +1,441 @@
+#ifndef ISLASDISTRIBUIDAS_H
+#define ISLASDISTRIBUIDAS_H
+
+// Modelo de islas repartido en varios procesos que se comunican por sockets (solo POSIX)
+#ifndef _WIN32
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+#include "Aleatorio.h"
+#include "Cromosoma.h"
+#include "Cultivacion.h"
+#include "ModeloIslas.h"
+#include "Serializacion.h"
+
+// Direccion de un socket: "unix:/ruta/al/socket" o "tcp:host:puerto" (puerto 0 = elegido por el sistema)
+struct DireccionSocket {
+    bool local = true;  // true = socket de dominio Unix, false = TCP
+    string ruta;        // Archivo del socket Unix
+    string host;        // Host TCP
+    int puerto = 0;     // Puerto TCP
+
+    bool interpretar(const string& texto) {
+        if (texto.compare(0, 5, "unix:") == 0 && texto.size() > 5) {
+            local = true;
+            ruta = texto.substr(5);
+            return ruta.size() < sizeof(sockaddr_un().sun_path);
+        }
+        if (texto.compare(0, 4, "tcp:") == 0) {
+            size_t separador = texto.rfind(':');
+            if (separador <= 4) return false;
+            local = false;
+            host = texto.substr(4, separador - 4);
+            puerto = atoi(texto.c_str() + separador + 1);
+            return puerto >= 0 && puerto < 65536;
+        }
+        return false;
+    }
+
+    string texto() const {
+        return local ? "unix:" + ruta : "tcp:" + host + ":" + to_string(puerto);
+    }
+};
+
+// Mensajes entre coordinador y trabajadores: uint32 tipo, uint32 longitud y 'longitud' bytes de datos
+enum TipoMensaje : uint32_t {
+    MENSAJE_HOLA = 1,       // Trabajador -> coordinador: uint32 identificador del trabajador
+    MENSAJE_MIGRANTES = 2,  // En ambos sentidos: uint32 cantidad y los cromosomas serializados
+    MENSAJE_RESULTADO = 3   // Trabajador -> coordinador: su mejor cromosoma
+};
+
+// Longitud maxima de los datos de un mensaje. Un paquete de migrantes ocupa unos 16 bytes por cultivo y mes de
+// cada cromosoma: 64 MiB alcanzan de sobra, y una cabecera erronea no hace reservar hasta 4 GiB
+const uint32_t MAXIMO_BYTES_MENSAJE = 64u << 20;
+
+inline bool escribirTodo(int descriptor, const char* datos, size_t bytes) {
+    while (bytes > 0) {
+        ssize_t escritos = send(descriptor, datos, bytes, MSG_NOSIGNAL);
+        if (escritos < 0 && errno == EINTR) continue;
+        if (escritos <= 0) return false;
+        datos += escritos;
+        bytes -= escritos;
+    }
+    return true;
+}
+
+inline bool leerTodo(int descriptor, char* datos, size_t bytes) {
+    while (bytes > 0) {
+        ssize_t leidos = recv(descriptor, datos, bytes, 0);
+        if (leidos < 0 && errno == EINTR) continue;
+        if (leidos <= 0) return false;
+        datos += leidos;
+        bytes -= leidos;
+    }
+    return true;
+}
+
+inline bool enviarMensaje(int descriptor, uint32_t tipo, const vector<char>& datos) {
+    vector<char> mensaje;
+    mensaje.reserve(2 * sizeof(uint32_t) + datos.size());
+    escribirValor(mensaje, tipo);
+    escribirValor(mensaje, static_cast<uint32_t>(datos.size()));
+    mensaje.insert(mensaje.end(), datos.begin(), datos.end());
+    return escribirTodo(descriptor, mensaje.data(), mensaje.size());
+}
+
+inline bool recibirMensaje(int descriptor, uint32_t& tipo, vector<char>& datos) {
+    uint32_t cabecera[2];
+    if (!leerTodo(descriptor, reinterpret_cast<char*>(cabecera), sizeof(cabecera))) return false;
+    tipo = cabecera[0];
+    if (cabecera[1] > MAXIMO_BYTES_MENSAJE) return false;
+    datos.resize(cabecera[1]);
+    return datos.empty() || leerTodo(descriptor, datos.data(), datos.size());
+}
+
+// Paquete de migrantes: uint32 cantidad seguido de cada cromosoma serializado
+inline void serializarMigrantes(const vector<Cromosoma>& migrantes, vector<char>& datos) {
+    datos.clear();
+    escribirValor(datos, static_cast<uint32_t>(migrantes.size()));
+    for (const Cromosoma& migrante : migrantes) serializarCromosoma(datos, migrante);
+}
+
+// Rechaza paquetes de mas de 'maximo' cromosomas o con cromosomas que no tienen 'dimension' genes, que no
+// caben en las filas de la poblacion
+inline bool deserializarMigrantes(const vector<char>& datos, size_t dimension, size_t maximo, vector<Cromosoma>& migrantes) {
+    const char* cursor = datos.data();
+    const char* fin = cursor + datos.size();
+    uint32_t cantidad = 0;
+    if (!leerValor(cursor, fin, cantidad) || cantidad > maximo) return false;
+    migrantes.resize(cantidad);
+    for (Cromosoma& migrante : migrantes) {
+        if (!deserializarCromosoma(cursor, fin, migrante) || migrante.genes.size() != dimension) return false;
+    }
+    return cursor == fin;
+}
+
+// Crear el socket de escucha; con TCP y puerto 0 se anota en 'direccion' el puerto asignado
+inline int escucharEn(DireccionSocket& direccion, int pendientes) {
+    int descriptor = -1;
+    if (direccion.local) {
+        sockaddr_un dir;
+        memset(&dir, 0, sizeof(dir));
+        dir.sun_family = AF_UNIX;
+        strncpy(dir.sun_path, direccion.ruta.c_str(), sizeof(dir.sun_path) - 1);
+        unlink(direccion.ruta.c_str());
+        descriptor = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (descriptor < 0) return -1;
+        if (bind(descriptor, reinterpret_cast<sockaddr*>(&dir), sizeof(dir)) != 0) {
+            close(descriptor);
+            return -1;
+        }
+    } else {
+        addrinfo pista, *resultados = nullptr;
+        memset(&pista, 0, sizeof(pista));
+        pista.ai_family = AF_INET;
+        pista.ai_socktype = SOCK_STREAM;
+        pista.ai_flags = AI_PASSIVE;
+        if (getaddrinfo(direccion.host.c_str(), to_string(direccion.puerto).c_str(), &pista, &resultados) != 0) return -1;
+        descriptor = socket(AF_INET, SOCK_STREAM, 0);
+        int uno = 1;
+        sockaddr_in dir;
+        socklen_t longitud = sizeof(dir);
+        bool enlazado = descriptor >= 0 && setsockopt(descriptor, SOL_SOCKET, SO_REUSEADDR, &uno, sizeof(uno)) == 0 &&
+                        bind(descriptor, resultados->ai_addr, resultados->ai_addrlen) == 0 &&
+                        getsockname(descriptor, reinterpret_cast<sockaddr*>(&dir), &longitud) == 0;
+        freeaddrinfo(resultados);
+        if (!enlazado) {
+            if (descriptor >= 0) close(descriptor);
+            return -1;
+        }
+        direccion.puerto = ntohs(dir.sin_port);
+    }
+    if (listen(descriptor, pendientes) != 0) {
+        close(descriptor);
+        return -1;
+    }
+    return descriptor;
+}
+
+inline int conectarA(const DireccionSocket& direccion) {
+    int descriptor = -1;
+    if (direccion.local) {
+        sockaddr_un dir;
+        memset(&dir, 0, sizeof(dir));
+        dir.sun_family = AF_UNIX;
+        strncpy(dir.sun_path, direccion.ruta.c_str(), sizeof(dir.sun_path) - 1);
+        descriptor = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (descriptor >= 0 && connect(descriptor, reinterpret_cast<sockaddr*>(&dir), sizeof(dir)) == 0) return descriptor;
+    } else {
+        addrinfo pista, *resultados = nullptr;
+        memset(&pista, 0, sizeof(pista));
+        pista.ai_family = AF_INET;
+        pista.ai_socktype = SOCK_STREAM;
+        if (getaddrinfo(direccion.host.c_str(), to_string(direccion.puerto).c_str(), &pista, &resultados) != 0) return -1;
+        descriptor = socket(AF_INET, SOCK_STREAM, 0);
+        bool conectado = descriptor >= 0 && connect(descriptor, resultados->ai_addr, resultados->ai_addrlen) == 0;
+        freeaddrinfo(resultados);
+        if (conectado) {
+            int uno = 1;  // Los paquetes de migrantes son pequenos: enviarlos sin esperar a llenar un segmento
+            setsockopt(descriptor, IPPROTO_TCP, TCP_NODELAY, &uno, sizeof(uno));
+            return descriptor;
+        }
+    }
+    if (descriptor >= 0) close(descriptor);
+    return -1;
+}
+
+// Islas en varios procesos. Cada trabajador es un proceso con su propio ModeloIslas; cada
+// intervaloMigracion generaciones envia sus mejores cromosomas al coordinador, que los reenvia al
+// trabajador siguiente del anillo. Al terminar cada trabajador envia su mejor cromosoma y el coordinador
+// se queda con el mejor de todos. Como cada trabajador recibe siempre el paquete de la misma migracion de
+// su vecino, el resultado no depende del orden en que lleguen los mensajes
+class IslasDistribuidas {
+   public:
+    int numeroProcesos = 2;       // Procesos trabajadores
+    int islasPorProceso = 1;      // Islas (hilos) dentro de cada trabajador
+    int intervaloMigracion = 10;  // Generaciones entre migraciones
+    int numeroMigrantes = 2;      // Cromosomas enviados al trabajador vecino en cada migracion
+    DireccionSocket direccion;    // Donde escucha el coordinador
+    OperadorSeleccion seleccion;  // Seleccion de padres de las islas de todos los trabajadores
+    TipoMuestreo muestreo = MUESTREO_RECHAZO;  // Sorteo de siembras de las islas de todos los trabajadores
+    bool podarPorCota = true;     // Descartar sin evaluar los hijos que no pueden sobrevivir
+
+    IslasDistribuidas(int numeroProcesos, int islasPorProceso, int intervaloMigracion, int numeroMigrantes)
+        : numeroProcesos(max(1, numeroProcesos)), islasPorProceso(max(1, islasPorProceso)),
+          intervaloMigracion(max(1, intervaloMigracion)), numeroMigrantes(max(0, numeroMigrantes)) {
+        direccion.ruta = "/tmp/algoritmoga-" + to_string(getpid()) + ".sock";
+    }
+
+    // Semilla del trabajador 'identificador', derivada de la semilla de la corrida
+    static uint64_t semillaTrabajador(uint64_t semilla, int identificador) {
+        GeneradorAleatorio generador(semilla, 0xD157ULL + static_cast<uint64_t>(identificador));
+        return generador();
+    }
+
+    // Lado del coordinador: escucha, lanza los trabajadores con 'ejecutable', reenvia los migrantes y recoge
+    // el mejor cromosoma de cada uno, que debe tener 'dimension' genes. Devuelve false (tras avisar por cerr) si algo falla
+    bool coordinar(const char* ejecutable, uint64_t semilla, int maximoGeneraciones, size_t dimension, Cromosoma& mejorCromosoma) {
+        int escucha = escucharEn(direccion, numeroProcesos);
+        if (escucha < 0) {
+            cerr << "No se pudo escuchar en " << direccion.texto() << ": " << strerror(errno) << endl;
+            return false;
+        }
+
+        vector<pid_t> procesos;
+        for (int k = 0; k < numeroProcesos; ++k) {
+            pid_t proceso = lanzarTrabajador(ejecutable, k, semilla, maximoGeneraciones);
+            if (proceso < 0) break;
+            procesos.push_back(proceso);
+        }
+
+        vector<int> conexiones(numeroProcesos, -1);  // conexiones[k] = socket del trabajador k
+        vector<Cromosoma> resultados(numeroProcesos);
+        bool correcto = static_cast<int>(procesos.size()) == numeroProcesos && aceptarTrabajadores(escucha, procesos, conexiones) &&
+                        reenviarMigrantes(conexiones, dimension, resultados);
+        close(escucha);
+        if (direccion.local) unlink(direccion.ruta.c_str());
+
+        for (int conexion : conexiones) {
+            if (conexion >= 0) close(conexion);
+        }
+        for (pid_t proceso : procesos) {
+            int estado = 0;
+            if (!correcto) kill(proceso, SIGTERM);
+            if (waitpid(proceso, &estado, 0) != proceso || !WIFEXITED(estado) || WEXITSTATUS(estado) != 0) correcto = false;
+        }
+        if (!correcto) {
+            cerr << "La corrida distribuida fallo" << endl;
+            return false;
+        }
+
+        // El trabajador de menor identificador gana los empates
+        int mejor = 0;
+        for (int k = 1; k < numeroProcesos; ++k) {
+            if (resultados[k].valorObjetivo > resultados[mejor].valorObjetivo) mejor = k;
+        }
+        mejorCromosoma = resultados[mejor];
+        return true;
+    }
+
+    // Lado del trabajador: conecta con el coordinador, evoluciona sus islas intercambiando migrantes y envia
+    // su mejor cromosoma. Devuelve el codigo de salida del proceso
+    int trabajar(int identificador, int tamanoPoblacion, int maximoGeneraciones, int numeroCultivos, int meses,
+                 Cultivacion& cultivacion, uint64_t semilla) {
+        int conexion = conectarA(direccion);
+        if (conexion < 0) {
+            cerr << "Trabajador " << identificador << ": no se pudo conectar a " << direccion.texto() << ": " << strerror(errno) << endl;
+            return 1;
+        }
+        vector<char> datos;
+        escribirValor(datos, static_cast<uint32_t>(identificador));
+        bool correcto = enviarMensaje(conexion, MENSAJE_HOLA, datos);
+
+        ModeloIslas modelo(islasPorProceso, intervaloMigracion, numeroMigrantes);
+        modelo.seleccion = seleccion;
+        modelo.muestreo = muestreo;
+        modelo.podarPorCota = podarPorCota;
+        modelo.inicializar(tamanoPoblacion, numeroCultivos, meses, cultivacion, semillaTrabajador(semilla, identificador));
+
+        // Evolucionar por tramos de intervaloMigracion generaciones; entre tramos, migrar entre procesos
+        vector<Cromosoma> migrantes;
+        int realizadas = 0;
+        while (correcto && realizadas < maximoGeneraciones) {
+            int tramo = min(intervaloMigracion, maximoGeneraciones - realizadas);
+            modelo.evolucionar(tramo, numeroCultivos, meses, cultivacion);
+            realizadas += tramo;
+            if (numeroProcesos > 1 && numeroMigrantes > 0 && realizadas < maximoGeneraciones) {
+                modelo.seleccionarMejores(numeroMigrantes, migrantes);
+                serializarMigrantes(migrantes, datos);
+                uint32_t tipo = 0;
+                correcto = enviarMensaje(conexion, MENSAJE_MIGRANTES, datos) && recibirMensaje(conexion, tipo, datos) &&
+                           tipo == MENSAJE_MIGRANTES &&
+                           deserializarMigrantes(datos, numeroCultivos * meses, numeroMigrantes, migrantes);
+                if (correcto) modelo.reemplazarPeores(migrantes);
+            }
+        }
+
+        if (correcto) {
+            datos.clear();
+            serializarCromosoma(datos, modelo.mejorCromosoma());
+            correcto = enviarMensaje(conexion, MENSAJE_RESULTADO, datos);
+        }
+        close(conexion);
+        if (!correcto) {
+            cerr << "Trabajador " << identificador << ": se perdio la conexion con el coordinador" << endl;
+            return 1;
+        }
+        return 0;
+    }
+
+   private:
+    // Cada trabajador recibe todas las opciones de la corrida que cambian su evolucion
+    pid_t lanzarTrabajador(const char* ejecutable, int identificador, uint64_t semilla, int maximoGeneraciones) {
+        vector<string> argumentos = {ejecutable,
+                                     "--trabajador", direccion.texto(),
+                                     "--id", to_string(identificador),
+                                     "--procesos", to_string(numeroProcesos),
+                                     "--seed", to_string(semilla),
+                                     "--generaciones", to_string(maximoGeneraciones),
+                                     "--islas", to_string(islasPorProceso),
+                                     "--intervalo", to_string(intervaloMigracion),
+                                     "--migrantes", to_string(numeroMigrantes),
+                                     "--muestreo", nombreMuestreo(muestreo)};
+        // --torneo tambien elige la seleccion por torneo
+        if (seleccion.tipo == SELECCION_TORNEO) {
+            argumentos.insert(argumentos.end(), {"--torneo", to_string(seleccion.tamanoTorneo)});
+        } else {
+            argumentos.insert(argumentos.end(), {"--seleccion", nombreSeleccion(seleccion.tipo)});
+        }
+        if (!podarPorCota) argumentos.push_back("--sin-cota");
+        pid_t proceso = fork();
+        if (proceso == 0) {
+            vector<char*> punteros;
+            for (string& argumento : argumentos) punteros.push_back(&argumento[0]);
+            punteros.push_back(nullptr);
+            execvp(ejecutable, punteros.data());
+            cerr << "No se pudo ejecutar " << ejecutable << ": " << strerror(errno) << endl;
+            _exit(127);
+        }
+        if (proceso < 0) cerr << "No se pudo crear el trabajador " << identificador << ": " << strerror(errno) << endl;
+        return proceso;
+    }
+
+    // Aceptar una conexion por trabajador y ubicarla segun el identificador de su saludo. Se deja de esperar
+    // si algun trabajador termina antes de conectarse
+    bool aceptarTrabajadores(int escucha, const vector<pid_t>& procesos, vector<int>& conexiones) {
+        vector<char> datos;
+        for (int conectados = 0; conectados < numeroProcesos;) {
+            pollfd espera = {escucha, POLLIN, 0};
+            int listos = poll(&espera, 1, 100);
+            if (listos < 0 && errno != EINTR) return false;
+            if (listos <= 0) {
+                for (pid_t proceso : procesos) {
+                    if (waitpid(proceso, nullptr, WNOHANG) == proceso) return false;
+                }
+                continue;
+            }
+            int conexion = accept(escucha, nullptr, nullptr);
+            if (conexion < 0) continue;
+            uint32_t tipo = 0, identificador = numeroProcesos;
+            if (recibirMensaje(conexion, tipo, datos) && tipo == MENSAJE_HOLA) {
+                const char* cursor = datos.data();
+                leerValor(cursor, datos.data() + datos.size(), identificador);
+            }
+            if (identificador >= static_cast<uint32_t>(numeroProcesos) || conexiones[identificador] >= 0) {
+                close(conexion);
+                return false;
+            }
+            if (!direccion.local) {
+                int uno = 1;
+                setsockopt(conexion, IPPROTO_TCP, TCP_NODELAY, &uno, sizeof(uno));
+            }
+            conexiones[identificador] = conexion;
+            ++conectados;
+        }
+        return true;
+    }
+
+    // Reenviar cada paquete de migrantes del trabajador k al k + 1 hasta recibir todos los resultados. Todos los
+    // trabajadores migran las mismas veces, asi que se avanza por migraciones: primero se lee el mensaje de cada
+    // uno y solo despues se reenvian los paquetes. Un trabajador que ya envio espera su paquete sin escribir
+    // nada, asi que el coordinador nunca queda bloqueado escribiendole mientras el le escribe al coordinador
+    bool reenviarMigrantes(const vector<int>& conexiones, size_t dimension, vector<Cromosoma>& resultados) {
+        vector<pollfd> esperas(numeroProcesos);
+        vector<vector<char> > paquetes(numeroProcesos);
+        while (true) {
+            for (int k = 0; k < numeroProcesos; ++k) esperas[k] = {conexiones[k], POLLIN, 0};
+            int recibidos = 0, migraciones = 0;
+            while (recibidos < numeroProcesos) {
+                if (poll(esperas.data(), esperas.size(), -1) < 0) {
+                    if (errno == EINTR) continue;
+                    return false;
+                }
+                for (int k = 0; k < numeroProcesos; ++k) {
+                    if (esperas[k].revents == 0) continue;
+                    uint32_t tipo = 0;
+                    if (!recibirMensaje(conexiones[k], tipo, paquetes[k])) return false;
+                    if (tipo == MENSAJE_MIGRANTES) {
+                        ++migraciones;
+                    } else if (tipo == MENSAJE_RESULTADO) {
+                        const char* cursor = paquetes[k].data();
+                        if (!deserializarCromosoma(cursor, paquetes[k].data() + paquetes[k].size(), resultados[k]) ||
+                            resultados[k].genes.size() != dimension) {
+                            return false;
+                        }
+                    } else {
+                        return false;
+                    }
+                    esperas[k].fd = -1;  // poll ignora los descriptores negativos
+                    ++recibidos;
+                }
+            }
+            if (migraciones == 0) return true;  // Todos enviaron su resultado
+            if (migraciones != numeroProcesos) return false;
+            for (int k = 0; k < numeroProcesos; ++k) {
+                if (!enviarMensaje(conexiones[(k + 1) % numeroProcesos], MENSAJE_MIGRANTES, paquetes[k])) return false;
+            }
+        }
+    }
+};
+
+#endif /* _WIN32 */
+
+#endif /* ISLASDISTRIBUIDAS_H */
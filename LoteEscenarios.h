@@ -0,0 +1,193 @@
+#ifndef LOTEESCENARIOS_H
+#define LOTEESCENARIOS_H
+
+#include <algorithm>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+#include "Aleatorio.h"
+#include "ArchivoEscenarios.h"
+#include "Cromosoma.h"
+#include "Escenario.h"
+#include "Generacion.h"
+#include "GeneracionDispersa.h"
+#include "PlanSiembra.h"
+#include "PoolHilos.h"
+#include "Terminacion.h"
+
+// Resultado de la corrida de un escenario
+struct ResultadoEscenario {
+    string nombre;
+    uint64_t semilla = 0;         // Semilla usada, para repetir el escenario solo
+    Cromosoma mejorCromosoma;     // Mejor cromosoma encontrado
+    double segundos = 0.0;        // Duracion de la corrida
+    int generaciones = 0;         // Generaciones corridas antes de terminar
+    MotivoTerminacion motivo = SIN_TERMINAR;
+    uint64_t evaluaciones = 0;    // Evaluaciones reales de la funcion objetivo (fallos de la cache)
+    uint64_t mesesOmitidos = 0;   // Meses reutilizados por la evaluacion incremental
+};
+
+// Corre muchos escenarios en un solo proceso. Cada escenario es una corrida secuencial completa y el pool
+// reparte escenarios enteros entre sus hilos, empezando por los mas costosos. Cada hilo conserva su propia
+// Generacion entre escenarios, asi que la poblacion, los hijos, la cache y el evaluador reutilizan la memoria
+// ya reservada en lugar de pedirla otra vez en cada corrida. El resultado de cada escenario depende solo de
+// sus datos y su semilla, no del numero de hilos ni del orden en que se corren
+class LoteEscenarios {
+   public:
+    PoolHilos& poolHilos;
+    CriterioTerminacion terminacion;  // Criterios comunes a todos los escenarios; el maximo de generaciones es el de cada uno
+    OperadorSeleccion seleccion;      // Operador de seleccion de padres de todos los escenarios
+    TipoMuestreo muestreo = MUESTREO_RECHAZO;  // Sorteo de siembras de todos los escenarios
+    TipoRepresentacion representacion = REPRESENTACION_DENSA;  // Forma de los cromosomas de todos los escenarios
+    bool podarPorCota = true;         // Descartar sin evaluar los hijos que no pueden sobrevivir (solo densa)
+
+    explicit LoteEscenarios(PoolHilos& poolHilos) : poolHilos(poolHilos) {}
+
+    ~LoteEscenarios() {
+        for (Generacion* generacion : generaciones) delete generacion;
+        for (GeneracionDispersa* generacion : generacionesDispersas) delete generacion;
+    }
+
+    LoteEscenarios(const LoteEscenarios&) = delete;
+    LoteEscenarios& operator=(const LoteEscenarios&) = delete;
+
+    // Correr todos los escenarios; los que no fijan su semilla la derivan de 'semilla' y de su posicion
+    void correr(vector<Escenario>& escenarios, uint64_t semilla, vector<ResultadoEscenario>& resultados) {
+        correrTodos(static_cast<int>(escenarios.size()), semilla, resultados,
+                    [&](int i) { return escenarios[i].costo(); },
+                    [&](int i, int) -> Escenario& { return escenarios[i]; });
+    }
+
+    // Igual, pero cada escenario se copia del archivo proyectado justo antes de correrlo, en el hilo que lo corre
+    // y sobre un Escenario por hilo, asi que en memoria solo estan los escenarios en curso
+    void correr(const ArchivoEscenarios& archivo, uint64_t semilla, vector<ResultadoEscenario>& resultados) {
+        escenariosHilo.resize(poolHilos.numeroHilos());
+        correrTodos(archivo.size(), semilla, resultados,
+                    [&](int i) { return archivo.costo(i); },
+                    [&](int i, int hilo) -> Escenario& {
+                        archivo.cargar(i, escenariosHilo[hilo]);
+                        return escenariosHilo[hilo];
+                    });
+    }
+
+    // Un registro CSV por escenario
+    static void escribirResultados(ostream& salida, const vector<ResultadoEscenario>& resultados) {
+        salida << "escenario,semilla,valorObjetivo,segundos,generaciones,terminacion,evaluaciones,mesesOmitidos,genes" << endl;
+        for (const ResultadoEscenario& r : resultados) {
+            salida << r.nombre << "," << r.semilla << "," << r.mejorCromosoma.valorObjetivo << "," << r.segundos << ","
+                   << r.generaciones << "," << nombreMotivo(r.motivo) << "," << r.evaluaciones << "," << r.mesesOmitidos << ",";
+            for (size_t i = 0; i < r.mejorCromosoma.genes.size(); ++i) salida << (i > 0 ? " " : "") << r.mejorCromosoma.genes[i];
+            salida << endl;
+        }
+    }
+
+   private:
+    vector<Generacion*> generaciones;  // Una por hilo del pool, reutilizada de un escenario al siguiente
+    vector<GeneracionDispersa*> generacionesDispersas;  // Igual, con la representacion dispersa
+    vector<Escenario> escenariosHilo;  // Escenario cargado por cada hilo al leer de un archivo binario
+
+    template <class Costo, class Obtener>
+    void correrTodos(int total, uint64_t semilla, vector<ResultadoEscenario>& resultados, const Costo& costo, const Obtener& obtener) {
+        vector<int> orden(total);
+        for (int i = 0; i < total; ++i) orden[i] = i;
+        stable_sort(orden.begin(), orden.end(), [&](int a, int b) { return costo(a) > costo(b); });
+
+        while (static_cast<int>(generaciones.size()) < poolHilos.numeroHilos()) generaciones.push_back(new Generacion());
+        while (static_cast<int>(generacionesDispersas.size()) < poolHilos.numeroHilos()) {
+            generacionesDispersas.push_back(new GeneracionDispersa());
+        }
+        resultados.assign(total, ResultadoEscenario());
+        poolHilos.paraCada(total, [&](int k, int hilo) {
+            int i = orden[k];
+            Escenario& escenario = obtener(i, hilo);
+            if (!escenario.semillaDada) escenario.semilla = GeneradorAleatorio(semilla, 0x107EULL + i)();
+            if (representacion == REPRESENTACION_DISPERSA) {
+                correrEscenario(*generacionesDispersas[hilo], escenario, resultados[i]);
+            } else {
+                correrEscenario(*generaciones[hilo], escenario, resultados[i]);
+            }
+        });
+    }
+
+    void correrEscenario(Generacion& g, Escenario& e, ResultadoEscenario& resultado) const {
+        CriterioTerminacion criterio = terminacion;
+        criterio.maximoGeneraciones = e.maximoGeneraciones;
+        criterio.iniciar();
+
+        // Volver a empezar sin liberar la memoria de la corrida anterior
+        g.tamanoPoblacion = e.tamanoPoblacion;
+        g.semilla = e.semilla;
+        g.seleccion = seleccion;
+        g.muestreo = muestreo;
+        g.podarPorCota = podarPorCota;
+        g.numeroGeneracion = 0;
+        g.poblacion.limpiar();
+        g.cacheAptitud.limpiar();
+        g.cacheAptitud.reiniciarContadores();
+        g.mesesEvaluados = 0;
+        g.mesesOmitidos = 0;
+        g.hijosAcotados = 0;
+        g.hijosDescartados = 0;
+
+        g.inicializarCromosomas(e.numeroCultivos, e.meses, e.cultivacion);
+        g.inicializarValoresObjetivo(e.numeroCultivos, e.meses, e.cultivacion);
+        EstadisticasGeneracion estadisticas;
+        estadisticas.calcular(g.poblacion, 0);
+        resultado.mejorCromosoma = g.poblacion.extraer(estadisticas.indiceMejor);
+        while (criterio.continuar(estadisticas)) {
+            g.obtenerNuevaGeneracion(e.tamanoPoblacion, e.numeroCultivos, e.meses, e.cultivacion);
+            estadisticas.calcular(g.poblacion, static_cast<int>(g.numeroGeneracion));
+            if (estadisticas.mejor > resultado.mejorCromosoma.valorObjetivo) {
+                resultado.mejorCromosoma = g.poblacion.extraer(estadisticas.indiceMejor);
+            }
+        }
+
+        resultado.nombre = e.nombre;
+        resultado.semilla = e.semilla;
+        resultado.segundos = criterio.segundosTranscurridos();
+        resultado.generaciones = estadisticas.generacion;
+        resultado.motivo = criterio.motivo;
+        resultado.evaluaciones = g.cacheAptitud.fallos.load();
+        resultado.mesesOmitidos = g.mesesOmitidos;
+    }
+
+    // Igual con planes de siembra dispersos; cada hijo se evalua al producirlo, sin cache
+    void correrEscenario(GeneracionDispersa& g, Escenario& e, ResultadoEscenario& resultado) const {
+        CriterioTerminacion criterio = terminacion;
+        criterio.maximoGeneraciones = e.maximoGeneraciones;
+        criterio.iniciar();
+
+        g.tamanoPoblacion = e.tamanoPoblacion;
+        g.semilla = e.semilla;
+        g.seleccion = seleccion;
+        g.muestreo = muestreo;
+        g.reiniciar();
+
+        g.inicializarPlanes(e.numeroCultivos, e.meses, e.cultivacion);
+        g.inicializarValoresObjetivo(e.numeroCultivos, e.meses, e.cultivacion);
+        EstadisticasGeneracion estadisticas;
+        estadisticas.calcular(g.valoresObjetivo.data(), static_cast<int>(g.valoresObjetivo.size()), 0);
+        resultado.mejorCromosoma = g.extraer(estadisticas.indiceMejor, e.numeroCultivos, e.meses, e.cultivacion.mesesCultivo);
+        while (criterio.continuar(estadisticas)) {
+            g.obtenerNuevaGeneracion(e.tamanoPoblacion, e.numeroCultivos, e.meses, e.cultivacion);
+            estadisticas.calcular(g.valoresObjetivo.data(), static_cast<int>(g.valoresObjetivo.size()), static_cast<int>(g.numeroGeneracion));
+            if (estadisticas.mejor > resultado.mejorCromosoma.valorObjetivo) {
+                resultado.mejorCromosoma = g.extraer(estadisticas.indiceMejor, e.numeroCultivos, e.meses, e.cultivacion.mesesCultivo);
+            }
+        }
+
+        resultado.nombre = e.nombre;
+        resultado.semilla = e.semilla;
+        resultado.segundos = criterio.segundosTranscurridos();
+        resultado.generaciones = estadisticas.generacion;
+        resultado.motivo = criterio.motivo;
+        resultado.evaluaciones = g.evaluaciones;
+        resultado.mesesOmitidos = 0;
+    }
+};
+
+#endif /* LOTEESCENARIOS_H */
@@ -0,0 +1,248 @@
+#ifndef MODELOISLAS_H
+#define MODELOISLAS_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+#include "Aleatorio.h"
+#include "Cromosoma.h"
+#include "Cultivacion.h"
+#include "Generacion.h"
+#include "Poblacion.h"
+#include "Terminacion.h"
+
+// Canal de un solo productor y un solo consumidor entre dos islas vecinas, sin candados: un anillo de
+// paquetes de migrantes reservados de antemano y dos contadores atomicos. El paquete k corresponde a la
+// migracion k, asi que cada isla recibe siempre los mismos migrantes sin importar la velocidad de los hilos
+class CanalMigrantes {
+   public:
+    static const int CAPACIDAD = 4;  // Migraciones que el productor puede adelantarse al consumidor
+
+    CanalMigrantes() : escritos(0), leidos(0) {}
+
+    CanalMigrantes(const CanalMigrantes&) = delete;
+    CanalMigrantes& operator=(const CanalMigrantes&) = delete;
+
+    void preparar(int numeroMigrantes, int dimension, int meses) {
+        for (Poblacion& paquete : paquetes) {
+            paquete.redimensionar(numeroMigrantes, dimension);
+            paquete.prepararEstados(meses);  // Los migrantes viajan con sus estados por mes
+        }
+    }
+
+    // Paquete donde escribir la siguiente migracion; espera si el consumidor va CAPACIDAD migraciones atras
+    Poblacion& paqueteParaEscribir() {
+        uint64_t siguiente = escritos.load(memory_order_relaxed);
+        while (siguiente - leidos.load(memory_order_acquire) >= CAPACIDAD) this_thread::yield();
+        return paquetes[siguiente % CAPACIDAD];
+    }
+
+    void publicar() {
+        escritos.store(escritos.load(memory_order_relaxed) + 1, memory_order_release);
+    }
+
+    // Paquete de la siguiente migracion; espera a que el productor lo publique
+    const Poblacion& paqueteParaLeer() {
+        uint64_t siguiente = leidos.load(memory_order_relaxed);
+        while (escritos.load(memory_order_acquire) == siguiente) this_thread::yield();
+        return paquetes[siguiente % CAPACIDAD];
+    }
+
+    void liberar() {
+        leidos.store(leidos.load(memory_order_relaxed) + 1, memory_order_release);
+    }
+
+   private:
+    Poblacion paquetes[CAPACIDAD];
+    atomic<uint64_t> escritos;  // Solo lo escribe el productor
+    atomic<uint64_t> leidos;    // Solo lo escribe el consumidor
+};
+
+// Modelo de islas: varias poblaciones independientes, cada una en su propio hilo, que cada
+// intervaloMigracion generaciones envian copias de sus mejores cromosomas a la siguiente isla del anillo,
+// donde reemplazan a los peores
+class ModeloIslas {
+   public:
+    int numeroIslas = 4;          // Poblaciones independientes
+    int intervaloMigracion = 10;  // Generaciones entre migraciones
+    int numeroMigrantes = 2;      // Cromosomas enviados a la isla vecina en cada migracion
+    vector<Generacion*> islas;    // Una Generacion por isla, sin pool: cada isla usa un solo hilo
+    vector<Cromosoma> mejores;    // Mejor cromosoma visto en cada isla
+    TipoMuestreo muestreo = MUESTREO_RECHAZO;  // Sorteo de siembras de todas las islas
+    OperadorSeleccion seleccion;               // Seleccion de padres de todas las islas
+    bool podarPorCota = true;                  // Descartar sin evaluar los hijos que no pueden sobrevivir
+
+    ModeloIslas(int numeroIslas, int intervaloMigracion, int numeroMigrantes)
+        : numeroIslas(max(1, numeroIslas)), intervaloMigracion(max(1, intervaloMigracion)), numeroMigrantes(max(0, numeroMigrantes)) {}
+
+    ~ModeloIslas() {
+        for (Generacion* isla : islas) delete isla;
+        for (CanalMigrantes* canal : canales) delete canal;
+    }
+
+    ModeloIslas(const ModeloIslas&) = delete;
+    ModeloIslas& operator=(const ModeloIslas&) = delete;
+
+    // Crear e inicializar las islas; cada una tiene su propia semilla derivada de la semilla de la corrida
+    void inicializar(int tamanoPoblacion, int numeroCultivos, int meses, Cultivacion& cultivacion, uint64_t semilla) {
+        int dimension = numeroCultivos * meses;
+        numeroMigrantes = min(numeroMigrantes, tamanoPoblacion);
+        GeneradorAleatorio generadorSemillas(semilla, 0x15A5ULL);
+        for (int k = 0; k < numeroIslas; ++k) {
+            Generacion* isla = new Generacion(0, dimension);
+            isla->tamanoPoblacion = tamanoPoblacion;
+            isla->semilla = generadorSemillas();
+            isla->muestreo = muestreo;
+            isla->seleccion = seleccion;
+            isla->podarPorCota = podarPorCota;
+            islas.push_back(isla);
+
+            CanalMigrantes* canal = new CanalMigrantes();
+            canal->preparar(numeroMigrantes, dimension, meses);
+            canales.push_back(canal);
+        }
+        mejores.resize(numeroIslas);
+        ordenes.resize(numeroIslas);
+
+        // Las poblaciones iniciales tambien se crean en paralelo, una isla por hilo. Las islas comparten
+        // 'cultivacion', asi que su indice de factibilidad se construye antes y los hilos solo lo leen
+        cultivacion.prepararFactibilidad(numeroCultivos, meses);
+        enCadaIsla([&](int k) {
+            islas[k]->inicializarCromosomas(numeroCultivos, meses, cultivacion);
+            islas[k]->inicializarValoresObjetivo(numeroCultivos, meses, cultivacion);
+            mejores[k] = islas[k]->encontrarMejorCromosoma();
+        });
+    }
+
+    // Evolucionar todas las islas maximoGeneraciones generaciones. Las islas solo se esperan entre vecinas
+    // al recibir migrantes, por el canal que las une
+    void evolucionar(int maximoGeneraciones, int numeroCultivos, int meses, Cultivacion& cultivacion) {
+        cultivacion.prepararFactibilidad(numeroCultivos, meses);
+        enCadaIsla([&](int k) {
+            Generacion& isla = *islas[k];
+            for (int generacion = 1; generacion <= maximoGeneraciones; ++generacion) {
+                isla.obtenerNuevaGeneracion(isla.tamanoPoblacion, numeroCultivos, meses, cultivacion);
+                actualizarMejor(k);
+                if (numeroIslas > 1 && numeroMigrantes > 0 && generacion % intervaloMigracion == 0) {
+                    migrar(k);
+                }
+            }
+        });
+    }
+
+    // Estadisticas de todas las islas juntas, como si fueran una sola poblacion
+    void calcularEstadisticas(EstadisticasGeneracion& estadisticas, int generacion) {
+        valores.clear();
+        for (const Generacion* isla : islas) {
+            const Poblacion& poblacion = isla->poblacion;
+            valores.insert(valores.end(), poblacion.valoresObjetivo.begin(), poblacion.valoresObjetivo.begin() + poblacion.size());
+        }
+        estadisticas.calcular(valores.data(), static_cast<int>(valores.size()), generacion);
+    }
+
+    // Los 'cantidad' mejores cromosomas de todas las islas, para enviarlos a otro proceso
+    void seleccionarMejores(int cantidad, vector<Cromosoma>& seleccionados) {
+        vector<pair<double, int> > candidatos;  // (valor objetivo, isla * tamano + fila)
+        int tamano = islas[0]->poblacion.size();
+        for (int k = 0; k < numeroIslas; ++k) {
+            const Poblacion& poblacion = islas[k]->poblacion;
+            for (int i = 0; i < poblacion.size(); ++i) candidatos.push_back(make_pair(poblacion.valoresObjetivo[i], k * tamano + i));
+        }
+        cantidad = min(cantidad, static_cast<int>(candidatos.size()));
+        partial_sort(candidatos.begin(), candidatos.begin() + cantidad, candidatos.end(),
+                     [](const pair<double, int>& a, const pair<double, int>& b) {
+                         return a.first > b.first || (a.first == b.first && a.second < b.second);
+                     });
+        seleccionados.clear();
+        for (int m = 0; m < cantidad; ++m) {
+            seleccionados.push_back(islas[candidatos[m].second / tamano]->poblacion.extraer(candidatos[m].second % tamano));
+        }
+    }
+
+    // Repartir cromosomas llegados de otro proceso entre las islas, reemplazando a los peores de cada una
+    void reemplazarPeores(const vector<Cromosoma>& llegados) {
+        for (int k = 0; k < numeroIslas; ++k) {
+            Poblacion& poblacion = islas[k]->poblacion;
+            ordenarPorValor(k);
+            int reemplazados = 0;
+            for (size_t m = k; m < llegados.size(); m += numeroIslas) {
+                int fila = ordenes[k][poblacion.size() - 1 - reemplazados++];
+                poblacion[fila].copiarDe(llegados[m].vista());
+                poblacion.valoresObjetivo[fila] = llegados[m].valorObjetivo;
+                poblacion.estadoValido[fila] = 0;
+            }
+            actualizarMejor(k);
+        }
+    }
+
+    // Mejor cromosoma entre todas las islas (la primera isla gana los empates)
+    Cromosoma mejorCromosoma() const {
+        int mejor = 0;
+        for (int k = 1; k < numeroIslas; ++k) {
+            if (mejores[k].valorObjetivo > mejores[mejor].valorObjetivo) mejor = k;
+        }
+        return mejores[mejor];
+    }
+
+   private:
+    vector<CanalMigrantes*> canales;  // canales[k] lleva migrantes de la isla k a la isla k + 1
+    vector<vector<int> > ordenes;     // Indices de cada isla ordenados por valor objetivo, para migrar
+    vector<double> valores;           // Valores objetivo de todas las islas, para las estadisticas
+
+    template <class Tarea>
+    void enCadaIsla(const Tarea& tarea) {
+        vector<thread> hilos;
+        for (int k = 1; k < numeroIslas; ++k) hilos.emplace_back([&tarea, k] { tarea(k); });
+        tarea(0);
+        for (thread& hilo : hilos) hilo.join();
+    }
+
+    void actualizarMejor(int k) {
+        const Poblacion& poblacion = islas[k]->poblacion;
+        int indiceMejor = 0;
+        for (int i = 1; i < poblacion.size(); ++i) {
+            if (poblacion.valoresObjetivo[i] > poblacion.valoresObjetivo[indiceMejor]) indiceMejor = i;
+        }
+        if (poblacion.valoresObjetivo[indiceMejor] > mejores[k].valorObjetivo) {
+            mejores[k] = poblacion.extraer(indiceMejor);
+        }
+    }
+
+    // Indices de la isla k de mejor a peor valor objetivo (en empate, la fila menor primero)
+    void ordenarPorValor(int k) {
+        const Poblacion& poblacion = islas[k]->poblacion;
+        vector<int>& orden = ordenes[k];
+        orden.resize(poblacion.size());
+        for (int i = 0; i < poblacion.size(); ++i) orden[i] = i;
+        sort(orden.begin(), orden.end(), [&](int a, int b) {
+            double valorA = poblacion.valoresObjetivo[a], valorB = poblacion.valoresObjetivo[b];
+            return valorA > valorB || (valorA == valorB && a < b);
+        });
+    }
+
+    // Enviar los mejores a la isla siguiente y reemplazar los peores por los que llegan de la anterior
+    void migrar(int k) {
+        Poblacion& poblacion = islas[k]->poblacion;
+        ordenarPorValor(k);
+        const vector<int>& orden = ordenes[k];
+
+        CanalMigrantes& salida = *canales[k];
+        Poblacion& paquete = salida.paqueteParaEscribir();
+        for (int m = 0; m < numeroMigrantes; ++m) paquete.copiarFila(m, poblacion, orden[m]);
+        salida.publicar();
+
+        CanalMigrantes& entrada = *canales[(k + numeroIslas - 1) % numeroIslas];
+        const Poblacion& recibidos = entrada.paqueteParaLeer();
+        for (int m = 0; m < numeroMigrantes; ++m) {
+            poblacion.copiarFila(orden[poblacion.size() - 1 - m], recibidos, m);
+        }
+        entrada.liberar();
+    }
+};
+
+#endif /* MODELOISLAS_H */
@@ -0,0 +1,285 @@
+#ifndef MUESTREO_H
+#define MUESTREO_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+using namespace std;
+
+#include "Aleatorio.h"
+#include "ArenaTrabajo.h"
+#include "Cromosoma.h"
+#include "Cultivacion.h"
+#include "VistaCromosoma.h"
+
+enum TipoMuestreo {
+    MUESTREO_RECHAZO,      // Sortear y descartar lo que no sirve, como siempre; reproduce las corridas anteriores
+    MUESTREO_CONSTRUCTIVO  // Sortear solo entre lo que se acepta: misma distribucion con trabajo acotado
+};
+
+inline const char* nombreMuestreo(TipoMuestreo tipo) {
+    return tipo == MUESTREO_CONSTRUCTIVO ? "constructivo" : "rechazo";
+}
+
+// Interpretar el nombre de un muestreo ("rechazo" o "constructivo")
+inline bool interpretarMuestreo(const char* nombre, TipoMuestreo& tipo) {
+    if (strcmp(nombre, "rechazo") == 0) {
+        tipo = MUESTREO_RECHAZO;
+    } else if (strcmp(nombre, "constructivo") == 0) {
+        tipo = MUESTREO_CONSTRUCTIVO;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Lo que las integrales de abajo necesitan de cada extremo t: cada extremo cuesta una erf y una exp, y los
+// tramos seguidos comparten extremos
+struct ExtremoGamma {
+    double t;
+    double raiz;         // sqrt(t)
+    double exponencial;  // e^(-t)
+    double erfRaiz;      // erf(sqrt(t))
+
+    explicit ExtremoGamma(double t) : t(t), raiz(sqrt(t)), exponencial(exp(-t)), erfRaiz(erf(raiz)) {}
+
+    // t^b e^(-t) para b semientero
+    double potencia(double b) const {
+        double resultado = b > 0.0 ? raiz * exponencial : exponencial / raiz;
+        for (double k = 0.5; k < b - 0.25; k += 1.0) resultado *= t;
+        for (double k = -0.5; k > b + 0.25; k -= 1.0) resultado /= t;
+        return resultado;
+    }
+};
+
+// Integral de t^(a-1) e^(-t) entre dos extremos para 'a' semientero (..., -1/2, 1/2, 3/2, ...). Parte de
+// a = 1/2, que se expresa con erf, y sube o baja de uno en uno con la recurrencia de la gamma incompleta
+// Gamma(a + 1, t) = a Gamma(a, t) + t^a e^(-t). Con a < 1/2 el extremo inferior debe ser positivo
+inline double integralGamma(double a, const ExtremoGamma& desde, const ExtremoGamma& hasta) {
+    const double RAIZ_PI = 1.7724538509055160273;
+    double integral = RAIZ_PI * (hasta.erfRaiz - desde.erfRaiz);
+    double p0 = desde.raiz * desde.exponencial, p1 = hasta.raiz * hasta.exponencial;  // t^b e^(-t), b = 1/2, 3/2, ...
+    for (double b = 0.5; b < a - 0.25; b += 1.0, p0 *= desde.t, p1 *= hasta.t) integral = b * integral + p0 - p1;
+    if (a < 0.0) {
+        p0 = desde.exponencial / desde.raiz;  // b = -1/2, -3/2, ...
+        p1 = hasta.exponencial / hasta.raiz;
+        for (double b = -0.5; b > a - 0.25; b -= 1.0, p0 /= desde.t, p1 /= hasta.t) integral = (integral - p0 + p1) / b;
+    }
+    return max(0.0, integral);
+}
+
+inline double integralGamma(double a, double t0, double t1) {
+    return integralGamma(a, ExtremoGamma(t0), ExtremoGamma(t1));
+}
+
+// Punto t entre los extremos donde integralGamma(a, desde, t) vale 'objetivo', por Newton protegido con
+// biseccion a partir de 'inicial'. Newton duplica los digitos correctos en cada paso, asi que un paso de
+// Newton de menos de 1e-7 t ya deja el error por debajo del redondeo. Como mucho 64 pasos; desde un punto
+// inicial tomado de una tabla suele bastar uno
+inline double invertirIntegralGamma(double a, const ExtremoGamma& desde, double hasta, double objetivo, double inicial) {
+    double bajo = desde.t, alto = hasta, t = inicial;
+    for (int paso = 0; paso < 64 && alto - bajo > 1e-12 * alto; ++paso) {
+        ExtremoGamma extremo(t);
+        double diferencia = integralGamma(a, desde, extremo) - objetivo;
+        if (diferencia < 0.0) bajo = t;
+        else alto = t;
+        double derivada = extremo.potencia(a - 1.0);
+        double siguiente = derivada > 0.0 ? t - diferencia / derivada : bajo;
+        bool newton = siguiente > bajo && siguiente < alto;
+        if (!newton) siguiente = 0.5 * (bajo + alto);
+        if (newton && fabs(siguiente - t) <= 1e-7 * t) return siguiente;
+        t = siguiente;
+    }
+    return t;
+}
+
+// Sorteos de area sin rechazos, con la misma distribucion que los bucles de rechazo de los operadores.
+// El porcentaje de area es 8 X / 100 con X chi cuadrado de 5 grados de libertad: con t = X / 2 la densidad es
+// t^(3/2) e^(-t) / Gamma(5/2), el porcentaje 0.16 t, y pasa de 1 (area nula) cuando t > 6.25
+class MuestreoSiembra {
+   public:
+    // Porcentaje 8 X / 100 condicionado a no pasar de 1, como el do/while de ajustarAreaAsignada
+    static double porcentajeAreaTruncado(GeneradorAleatorio& gen) {
+        return 0.16 * cuantilCompleto(gen.uniforme());
+    }
+
+    // Como Cromosoma::inicializar, con la misma distribucion de cromosomas. En cada mes el bucle original repite
+    // sorteos que no cambian nada (cultivo no sembrable, agua insuficiente, area nula sobre un cultivo que no se
+    // ha sembrado en el mes) hasta que sale del mes o cambia el cromosoma; aqui se sortea directamente entre
+    // esas salidas con sus probabilidades exactas:
+    //  - salir del mes: 1 - q, con q la probabilidad de entrar al bucle;
+    //  - sembrar el cultivo sembrable c: q / numeroCultivos por la masa aceptada de su area (masaAceptada);
+    //  - area nula sobre el cultivo c ya sembrado en el mes, que deja su cultivoPlantado en 0.
+    // Cada siembra cuesta O(cultivos sembrables x periodo de crecimiento). Si el area del mes esta libre y
+    // ninguna siembra se puede aceptar, el bucle original no termina nunca; aqui se pasa al mes siguiente
+    static void inicializar(VistaCromosoma nuevoCromosoma, int numeroCultivos, int meses, const vector<int>& mesesCultivo,
+                            const vector<double>& requerimientoAgua, const IndiceFactibilidad& factibilidad,
+                            const vector<double>& aguaInicialDisponible, double areaTotalDisponible, ArenaTrabajo& arena,
+                            GeneradorAleatorio& gen) {
+        nuevoCromosoma.limpiar();
+        Fila<double> areaDisponible = arena.reservar(meses, 1.0);
+        Fila<double> aguaDisponible = arena.copiar(aguaInicialDisponible);
+        Fila<double> pesos = arena.reservar<double>(2 * numeroCultivos);
+        Fila<double> limites = arena.reservar<double>(mesesMaximos(mesesCultivo, numeroCultivos));
+        double probabilidadAreaNula = 1.0 - masaCompleta();
+
+        for (int mes = 0; mes < meses; ++mes) {
+            int factibles = factibilidad.cultivosEnMes(mes);
+            const int* cultivos = factibilidad.primerCultivo(mes);
+            while (factibles > 0) {
+                double entrar = Cromosoma::probabilidadDeEntrarAlBucle(areaDisponible[mes]);
+                double porCultivo = entrar / numeroCultivos;
+                double total = 1.0 - entrar;
+                for (int k = 0; k < factibles; ++k) {
+                    int cultivo = cultivos[k];
+                    pesos[2 * k] = porCultivo * masaAceptada(calcularLimites(cultivo, mes, meses, mesesCultivo[cultivo], requerimientoAgua,
+                                                                             areaTotalDisponible, areaDisponible, aguaDisponible, limites));
+                    pesos[2 * k + 1] = nuevoCromosoma.cultivoPlantado[cultivo + numeroCultivos * mes] != 0.0 ? porCultivo * probabilidadAreaNula : 0.0;
+                    total += pesos[2 * k] + pesos[2 * k + 1];
+                }
+                if (total <= 0.0) break;
+
+                double u = gen.uniforme() * total;
+                if (u < 1.0 - entrar) break;
+                u -= 1.0 - entrar;
+                int opcion = -1;
+                for (int o = 0; o < 2 * factibles; ++o) {
+                    if (pesos[o] <= 0.0) continue;
+                    opcion = o;
+                    if (u < pesos[o]) break;
+                    u -= pesos[o];
+                }
+                if (opcion < 0) break;
+
+                int cultivo = cultivos[opcion / 2];
+                if (opcion % 2 == 1) {
+                    nuevoCromosoma.cultivoPlantado[cultivo + numeroCultivos * mes] = 0.0;
+                    continue;
+                }
+                double t = muestrearAceptado(calcularLimites(cultivo, mes, meses, mesesCultivo[cultivo], requerimientoAgua,
+                                                             areaTotalDisponible, areaDisponible, aguaDisponible, limites), gen);
+                double areaUsada = 0.16 * t * areaDisponible[mes];
+                Cromosoma::sembrar(nuevoCromosoma, numeroCultivos, meses, cultivo, mes, mesesCultivo[cultivo], areaUsada, requerimientoAgua,
+                                   areaTotalDisponible, areaDisponible, aguaDisponible);
+            }
+
+            // Transferir agua no usada al siguiente mes
+            if (mes < meses - 1) {
+                aguaDisponible[mes + 1] += aguaDisponible[mes];
+            }
+        }
+    }
+
+   private:
+    static constexpr double T_MAXIMO = 6.25;                     // t por encima del cual el area es nula
+    static constexpr double GAMMA_5_2 = 1.3293403881791355;      // Gamma(5/2)
+
+    static const int CUANTILES = 4096;                           // Intervalos de la tabla de cuantiles
+
+    // Periodo de crecimiento mas largo: cota del numero de limites de agua de una siembra
+    static int mesesMaximos(const vector<int>& mesesCultivo, int numeroCultivos) {
+        int maximo = 0;
+        for (int cultivo = 0; cultivo < numeroCultivos; ++cultivo) maximo = max(maximo, mesesCultivo[cultivo]);
+        return maximo;
+    }
+
+    static const ExtremoGamma& extremoCero() {
+        static const ExtremoGamma extremo(0.0);
+        return extremo;
+    }
+
+    static const ExtremoGamma& extremoMaximo() {
+        static const ExtremoGamma extremo(T_MAXIMO);
+        return extremo;
+    }
+
+    // Probabilidad de que un sorteo de area sea positivo (t <= T_MAXIMO)
+    static double masaCompleta() {
+        static const double masa = integralGamma(2.5, extremoCero(), extremoMaximo()) / GAMMA_5_2;
+        return masa;
+    }
+
+    // t con probabilidad acumulada u entre los sorteos de area positiva. Una tabla de cuantiles, calculada una
+    // vez, da el punto inicial y Newton lo termina en un paso
+    static double cuantilCompleto(double u) {
+        static const vector<double> tabla = calcularCuantiles();
+        double posicion = u * CUANTILES;
+        int k = min(CUANTILES - 1, static_cast<int>(posicion));
+        double inicial = tabla[k] + (posicion - k) * (tabla[k + 1] - tabla[k]);
+        return invertirIntegralGamma(2.5, extremoCero(), T_MAXIMO, u * masaCompleta() * GAMMA_5_2, inicial);
+    }
+
+    static vector<double> calcularCuantiles() {
+        vector<double> tabla(CUANTILES + 1, 0.0);
+        double total = masaCompleta() * GAMMA_5_2;
+        tabla[CUANTILES] = T_MAXIMO;
+        for (int k = 1; k < CUANTILES; ++k) {
+            double inicial = tabla[k - 1] + (T_MAXIMO - tabla[k - 1]) / (CUANTILES - k + 1);
+            tabla[k] = invertirIntegralGamma(2.5, extremoCero(), T_MAXIMO, total * k / CUANTILES, inicial);
+        }
+        return tabla;
+    }
+
+    // esAguaSuficiente acepta el area 0.16 t a con probabilidad prod_m min(1, l_m / t), donde
+    // l_m = W_m / (0.16 r A a) con W_m el agua de cada mes de la ventana. Devuelve, escritos al principio de
+    // 'espacio', los l_m menores que T_MAXIMO, ordenados: entre dos limites seguidos la densidad aceptada es
+    // (prod l) t^(3/2 - j) e^(-t)
+    static Fila<const double> calcularLimites(int cultivo, int mes, int meses, int periodoCrecimiento,
+                                              const vector<double>& requerimientoAgua, double areaTotalDisponible,
+                                              Fila<const double> areaDisponible, Fila<const double> aguaDisponible, Fila<double> espacio) {
+        size_t cantidad = 0;
+        double escala = 0.16 * requerimientoAgua[cultivo] * areaTotalDisponible * areaDisponible[mes];
+        if (escala <= 0.0) return Fila<const double>();
+        for (int m = 0; m < periodoCrecimiento && (mes + m) < meses; ++m) {
+            double limite = max(0.0, aguaDisponible[mes + m] / escala);
+            if (limite < T_MAXIMO) espacio[cantidad++] = limite;
+        }
+        sort(espacio.begin(), espacio.begin() + cantidad);
+        return Fila<const double>(espacio.data(), cantidad);
+    }
+
+    // Probabilidad de que un sorteo de area con esos limites sea positivo y pase la prueba de agua
+    static double masaAceptada(Fila<const double> limites) {
+        if (limites.empty()) return masaCompleta();  // El agua alcanza para cualquier area del mes
+        double masa = 0.0, producto = 1.0;
+        ExtremoGamma inicio = extremoCero();
+        for (size_t j = 0; j <= limites.size() && producto > 0.0; ++j) {
+            ExtremoGamma fin = j < limites.size() ? ExtremoGamma(limites[j]) : extremoMaximo();
+            if (fin.t > inicio.t) masa += producto * integralGamma(2.5 - j, inicio, fin);
+            if (j < limites.size()) producto *= limites[j];
+            inicio = fin;
+        }
+        return masa / GAMMA_5_2;
+    }
+
+    // t de un sorteo de area aceptado con esos limites: un tramo entre limites con probabilidad proporcional a su
+    // masa y dentro de el por inversion de la integral
+    static double muestrearAceptado(Fila<const double> limites, GeneradorAleatorio& gen) {
+        double masa = masaAceptada(limites);
+        if (limites.empty()) return cuantilCompleto(gen.uniforme());
+        double u = gen.uniforme() * GAMMA_5_2 * masa;
+        double producto = 1.0;
+        ExtremoGamma inicio = extremoCero();
+        ExtremoGamma desde = inicio;                   // Tramo elegido; por redondeo, el ultimo con masa
+        double a = 2.5, hasta = 0.0, objetivo = 0.0;
+        for (size_t j = 0; j <= limites.size() && producto > 0.0; ++j) {
+            ExtremoGamma fin = j < limites.size() ? ExtremoGamma(limites[j]) : extremoMaximo();
+            if (fin.t > inicio.t) {
+                double masaTramo = integralGamma(2.5 - j, inicio, fin);
+                a = 2.5 - j;
+                desde = inicio;
+                hasta = fin.t;
+                objetivo = min(u / producto, masaTramo);
+                if (u < producto * masaTramo) break;
+                u -= producto * masaTramo;
+            }
+            if (j < limites.size()) producto *= limites[j];
+            inicio = fin;
+        }
+        return hasta > desde.t ? invertirIntegralGamma(a, desde, hasta, objetivo, 0.5 * (desde.t + hasta)) : 0.0;
+    }
+};
+
+#endif /* MUESTREO_H */
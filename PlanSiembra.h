@@ -0,0 +1,92 @@
+#ifndef PLANSIEMBRA_H
+#define PLANSIEMBRA_H
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+using namespace std;
+
+#include "VistaCromosoma.h"
+
+enum TipoRepresentacion {
+    REPRESENTACION_DENSA,    // Matrices cultivos x meses de genes y cultivoPlantado (Poblacion)
+    REPRESENTACION_DISPERSA  // Lista de siembras por individuo (PlanSiembra)
+};
+
+// Interpretar el nombre de una representacion ("densa" o "dispersa")
+inline bool interpretarRepresentacion(const char* nombre, TipoRepresentacion& tipo) {
+    if (strcmp(nombre, "densa") == 0) {
+        tipo = REPRESENTACION_DENSA;
+    } else if (strcmp(nombre, "dispersa") == 0) {
+        tipo = REPRESENTACION_DISPERSA;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Siembra de un cultivo: ocupa 'area' (fraccion del area total) desde 'mes' durante su periodo de crecimiento
+struct EventoSiembra {
+    int cultivo;
+    int mes;
+    double area;
+};
+
+// Cromosoma disperso: la lista de sus siembras ordenada por mes en lugar de las matrices cultivos x meses.
+// genes[cultivo, mes] es la suma de las areas de las siembras del cultivo que cubren el mes y
+// cultivoPlantado[cultivo, mes] la de las que empiezan en el. Un plan tiene del orden de una siembra por
+// cultivo sembrado y mes, asi que ocupa y cuesta lo mismo con 5 cultivos que con 200
+class PlanSiembra {
+   public:
+    vector<EventoSiembra> eventos;  // Ordenados por mes; dentro de un mes, en el orden en que se sembraron
+    double valorObjetivo = 0.0;
+
+    int size() const { return static_cast<int>(eventos.size()); }
+
+    void limpiar() {
+        eventos.clear();
+        valorObjetivo = 0.0;
+    }
+
+    // Agregar una siembra; el llamador las agrega en orden de mes
+    void agregar(int cultivo, int mes, double area) {
+        EventoSiembra evento = {cultivo, mes, area};
+        eventos.push_back(evento);
+    }
+
+    // Posicion de la primera siembra del mes 'mes' o de uno posterior
+    int primeraDesde(int mes) const {
+        return static_cast<int>(lower_bound(eventos.begin(), eventos.end(), mes,
+                                            [](const EventoSiembra& e, int m) { return e.mes < m; }) - eventos.begin());
+    }
+
+    // Plan con las siembras de cultivoPlantado de un cromosoma denso
+    void desdeCromosoma(VistaConstCromosoma cromosoma, int numeroCultivos, int meses) {
+        limpiar();
+        for (int mes = 0; mes < meses; ++mes) {
+            for (int cultivo = 0; cultivo < numeroCultivos; ++cultivo) {
+                double area = cromosoma.cultivoPlantado[cultivo + numeroCultivos * mes];
+                if (area > 0.0) agregar(cultivo, mes, area);
+            }
+        }
+    }
+
+    // Escribir el plan como matrices densas, sobre una fila de la dimension del problema
+    void expandir(VistaCromosoma cromosoma, int numeroCultivos, int meses, const vector<int>& mesesCultivo) const {
+        cromosoma.limpiar();
+        for (const EventoSiembra& e : eventos) {
+            for (int m = 0; m < mesesCultivo[e.cultivo] && e.mes + m < meses; ++m) {
+                cromosoma.genes[e.cultivo + numeroCultivos * (e.mes + m)] += e.area;
+            }
+            cromosoma.cultivoPlantado[e.cultivo + numeroCultivos * e.mes] += e.area;
+        }
+    }
+
+    // Memoria que ocupa el plan, contando la reservada de mas en la lista
+    size_t bytes() const {
+        return sizeof(PlanSiembra) + eventos.capacity() * sizeof(EventoSiembra);
+    }
+};
+
+#endif /* PLANSIEMBRA_H */
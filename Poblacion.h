@@ -0,0 +1,187 @@
+#ifndef POBLACION_H
+#define POBLACION_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+using namespace std;
+
+#include "Cromosoma.h"
+#include "VistaCromosoma.h"
+
+// Asignador que alinea cada bloque a 'Alineacion' bytes (una linea de cache, un registro AVX-512)
+template <class T, size_t Alineacion = 64>
+class AsignadorAlineado {
+   public:
+    typedef T value_type;
+
+    template <class U>
+    struct rebind {
+        typedef AsignadorAlineado<U, Alineacion> other;
+    };
+
+    AsignadorAlineado() {}
+
+    template <class U>
+    AsignadorAlineado(const AsignadorAlineado<U, Alineacion>&) {}
+
+    T* allocate(size_t n) {
+        // Reservar de mas y guardar el puntero original justo antes del bloque alineado
+        void* original = ::operator new(n * sizeof(T) + Alineacion + sizeof(void*));
+        uintptr_t inicio = reinterpret_cast<uintptr_t>(original) + sizeof(void*);
+        uintptr_t alineado = (inicio + Alineacion - 1) & ~static_cast<uintptr_t>(Alineacion - 1);
+        reinterpret_cast<void**>(alineado)[-1] = original;
+        return reinterpret_cast<T*>(alineado);
+    }
+
+    void deallocate(T* p, size_t) {
+        ::operator delete(reinterpret_cast<void**>(p)[-1]);
+    }
+
+    template <class U>
+    bool operator==(const AsignadorAlineado<U, Alineacion>&) const { return true; }
+
+    template <class U>
+    bool operator!=(const AsignadorAlineado<U, Alineacion>&) const { return false; }
+};
+
+// Estado de la funcion objetivo al empezar un mes; con el de un mes basta para reanudar la evaluacion desde ahi
+struct EstadoMes {
+    double cosechaAcumulada;  // Cosecha de los meses anteriores
+    double conductividad;     // Conductividad electrica del suelo
+    double aguaArrastrada;    // Agua sobrante del mes anterior
+};
+
+// Poblacion almacenada como estructura de arreglos: los genes de todos los individuos forman una sola
+// matriz contigua tamano x paso (igual para cultivoPlantado), con cada fila alineada a 64 bytes.
+// Los individuos se manipulan a traves de vistas, sin un vector propio por cromosoma
+class Poblacion {
+   public:
+    static const int GENES_POR_LINEA = 64 / sizeof(TipoGen);  // Relleno de cada fila hasta la siguiente linea de cache
+
+    vector<TipoGen, AsignadorAlineado<TipoGen> > genes;            // Matriz tamano x paso de genes
+    vector<TipoGen, AsignadorAlineado<TipoGen> > cultivoPlantado;  // Matriz tamano x paso de areas plantadas
+    vector<double> valoresObjetivo;                              // Valor de la funcion objetivo de cada individuo
+    vector<EstadoMes> estados;                                   // Matriz tamano x mesesEstado del estado al inicio de cada mes
+    vector<char> estadoValido;                                   // Si los estados de la fila corresponden a sus genes actuales.
+                                                                 // Quien cambie los genes de una fila ya evaluada debe ponerlo en 0
+
+    Poblacion() : tamano(0), dimension(0), paso(0), mesesEstado(0) {}
+
+    Poblacion(int tamano, int dimension) : tamano(0), dimension(0), paso(0), mesesEstado(0) {
+        redimensionar(tamano, dimension);
+    }
+
+    int size() const { return tamano; }
+    bool empty() const { return tamano == 0; }
+    int obtenerDimension() const { return dimension; }
+    int obtenerPaso() const { return paso; }
+    int obtenerMesesEstado() const { return mesesEstado; }
+
+    // Cambiar el numero de individuos; las filas existentes se conservan y las nuevas quedan en cero
+    void redimensionar(int nuevoTamano, int nuevaDimension) {
+        if (nuevaDimension != dimension) {
+            dimension = nuevaDimension;
+            paso = (dimension + GENES_POR_LINEA - 1) / GENES_POR_LINEA * GENES_POR_LINEA;
+            genes.clear();
+            cultivoPlantado.clear();
+            estadoValido.clear();
+            tamano = 0;
+        }
+        tamano = nuevoTamano;
+        genes.resize(static_cast<size_t>(tamano) * paso, 0.0);
+        cultivoPlantado.resize(static_cast<size_t>(tamano) * paso, 0.0);
+        valoresObjetivo.resize(tamano, 0.0);
+        estados.resize(static_cast<size_t>(tamano) * mesesEstado);
+        estadoValido.resize(tamano, 0);
+    }
+
+    // Guardar el estado de cada mes para la evaluacion incremental; al cambiar los meses se invalidan todos
+    void prepararEstados(int meses) {
+        if (meses == mesesEstado) return;
+        mesesEstado = meses;
+        estados.assign(static_cast<size_t>(tamano) * mesesEstado, EstadoMes());
+        estadoValido.assign(tamano, 0);
+    }
+
+    EstadoMes* estadosFila(int i) {
+        return estados.data() + static_cast<size_t>(i) * mesesEstado;
+    }
+
+    const EstadoMes* estadosFila(int i) const {
+        return estados.data() + static_cast<size_t>(i) * mesesEstado;
+    }
+
+    void redimensionar(int nuevoTamano) {
+        redimensionar(nuevoTamano, dimension);
+    }
+
+    void reservar(int capacidad, int nuevaDimension) {
+        if (tamano == 0) redimensionar(0, nuevaDimension);
+        genes.reserve(static_cast<size_t>(capacidad) * paso);
+        cultivoPlantado.reserve(static_cast<size_t>(capacidad) * paso);
+        valoresObjetivo.reserve(capacidad);
+    }
+
+    void limpiar() {
+        redimensionar(0);
+    }
+
+    VistaCromosoma operator[](int i) {
+        size_t inicio = static_cast<size_t>(i) * paso;
+        return VistaCromosoma(Fila<TipoGen>(genes.data() + inicio, dimension), Fila<TipoGen>(cultivoPlantado.data() + inicio, dimension));
+    }
+
+    VistaConstCromosoma operator[](int i) const {
+        size_t inicio = static_cast<size_t>(i) * paso;
+        return VistaConstCromosoma(Fila<const TipoGen>(genes.data() + inicio, dimension), Fila<const TipoGen>(cultivoPlantado.data() + inicio, dimension));
+    }
+
+    // Agregar un individuo al final de la poblacion
+    void agregar(VistaConstCromosoma cromosoma, double valorObjetivo) {
+        if (tamano == 0 && dimension != static_cast<int>(cromosoma.genes.size())) {
+            redimensionar(0, static_cast<int>(cromosoma.genes.size()));
+        }
+        redimensionar(tamano + 1);
+        (*this)[tamano - 1].copiarDe(cromosoma);
+        valoresObjetivo[tamano - 1] = valorObjetivo;
+    }
+
+    void agregar(const Cromosoma& cromosoma) {
+        agregar(cromosoma.vista(), cromosoma.valorObjetivo);
+    }
+
+    // Copiar el individuo 'filaOrigen' de otra poblacion (o de esta) en la posicion 'destino', con sus estados
+    void copiarFila(int destino, const Poblacion& origen, int filaOrigen) {
+        (*this)[destino].copiarDe(origen[filaOrigen]);
+        valoresObjetivo[destino] = origen.valoresObjetivo[filaOrigen];
+        copiarEstados(destino, origen, filaOrigen);
+    }
+
+    void copiarEstados(int destino, const Poblacion& origen, int filaOrigen) {
+        bool compatibles = mesesEstado > 0 && mesesEstado == origen.mesesEstado;
+        if (compatibles && origen.estadoValido[filaOrigen]) {
+            copy(origen.estadosFila(filaOrigen), origen.estadosFila(filaOrigen) + mesesEstado, estadosFila(destino));
+        }
+        estadoValido[destino] = compatibles && origen.estadoValido[filaOrigen];
+    }
+
+    // Materializar un individuo como Cromosoma independiente (para reportes o para guardarlo como el mejor)
+    Cromosoma extraer(int i) const {
+        Cromosoma cromosoma(dimension);
+        cromosoma.vista().copiarDe((*this)[i]);
+        cromosoma.valorObjetivo = valoresObjetivo[i];
+        return cromosoma;
+    }
+
+   private:
+    int tamano;
+    int dimension;
+    int paso;         // Distancia en dobles entre el inicio de dos filas consecutivas
+    int mesesEstado;  // Meses guardados por fila en 'estados' (0 = sin estados)
+};
+
+#endif /* POBLACION_H */
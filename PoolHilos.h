@@ -0,0 +1,128 @@
+#ifndef POOLHILOS_H
+#define POOLHILOS_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// Pool de hilos fijo para repartir trabajos independientes (cruce, validacion, evaluacion) entre todos los nucleos
+class PoolHilos {
+   public:
+    explicit PoolHilos(int numeroHilos = 0)
+        : terminar(false), epoca(0), hilosPendientes(0), contexto(nullptr), invocar(nullptr), total(0), tamanoBloque(1), siguiente(0) {
+        if (numeroHilos <= 0) numeroHilos = max(1u, thread::hardware_concurrency());
+        // El hilo que llama a paraCada tambien trabaja, por eso se crean numeroHilos - 1 trabajadores
+        for (int h = 1; h < numeroHilos; ++h) {
+            trabajadores.emplace_back(&PoolHilos::bucleTrabajador, this, h);
+        }
+    }
+
+    ~PoolHilos() {
+        {
+            lock_guard<mutex> bloqueo(mutexTrabajo);
+            terminar = true;
+        }
+        cvTrabajo.notify_all();
+        for (thread& trabajador : trabajadores) {
+            trabajador.join();
+        }
+    }
+
+    PoolHilos(const PoolHilos&) = delete;
+    PoolHilos& operator=(const PoolHilos&) = delete;
+
+    int numeroHilos() const {
+        return static_cast<int>(trabajadores.size()) + 1;
+    }
+
+    // Ejecutar tarea(indice, hilo) para cada indice en [0, total) y esperar a que terminen todos.
+    // Los indices se reparten en bloques de tamanoBloque que cada hilo toma de un contador atomico.
+    // La tarea se recibe por referencia y se invoca a traves de un puntero a funcion, sin reservar memoria
+    template <class Tarea>
+    void paraCada(int totalTareas, const Tarea& tareaNueva, int bloque = 1) {
+        if (totalTareas <= 0) return;
+        if (trabajadores.empty() || totalTareas <= bloque) {
+            for (int i = 0; i < totalTareas; ++i) tareaNueva(i, 0);
+            return;
+        }
+
+        lock_guard<mutex> exclusivo(mutexLlamada);  // Un solo paraCada activo a la vez
+        {
+            lock_guard<mutex> bloqueo(mutexTrabajo);
+            contexto = &tareaNueva;
+            invocar = &invocarTarea<Tarea>;
+            total = totalTareas;
+            tamanoBloque = max(1, bloque);
+            siguiente.store(0);
+            hilosPendientes = static_cast<int>(trabajadores.size());
+            ++epoca;
+        }
+        cvTrabajo.notify_all();
+
+        procesarBloques(0);
+
+        unique_lock<mutex> bloqueo(mutexTrabajo);
+        cvTerminado.wait(bloqueo, [this] { return hilosPendientes == 0; });
+        contexto = nullptr;
+        invocar = nullptr;
+    }
+
+   private:
+    vector<thread> trabajadores;
+    mutex mutexLlamada;
+    mutex mutexTrabajo;
+    condition_variable cvTrabajo;
+    condition_variable cvTerminado;
+    bool terminar;
+    unsigned long epoca;
+    int hilosPendientes;
+
+    const void* contexto;                    // Tarea del paraCada en curso
+    void (*invocar)(const void*, int, int);  // Llama a la tarea con su tipo real
+    int total;
+    int tamanoBloque;
+    atomic<int> siguiente;
+
+    void procesarBloques(int hilo) {
+        while (true) {
+            int inicio = siguiente.fetch_add(tamanoBloque);
+            if (inicio >= total) break;
+            int fin = min(total, inicio + tamanoBloque);
+            for (int i = inicio; i < fin; ++i) {
+                invocar(contexto, i, hilo);
+            }
+        }
+    }
+
+    template <class Tarea>
+    static void invocarTarea(const void* contexto, int indice, int hilo) {
+        (*static_cast<const Tarea*>(contexto))(indice, hilo);
+    }
+
+    void bucleTrabajador(int hilo) {
+        unsigned long epocaVista = 0;
+        while (true) {
+            {
+                unique_lock<mutex> bloqueo(mutexTrabajo);
+                cvTrabajo.wait(bloqueo, [&] { return terminar || epoca != epocaVista; });
+                if (terminar) return;
+                epocaVista = epoca;
+            }
+
+            procesarBloques(hilo);
+
+            {
+                lock_guard<mutex> bloqueo(mutexTrabajo);
+                --hilosPendientes;
+            }
+            cvTerminado.notify_one();
+        }
+    }
+};
+
+#endif /* POOLHILOS_H */
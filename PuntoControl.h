@@ -0,0 +1,226 @@
+#ifndef PUNTOCONTROL_H
+#define PUNTOCONTROL_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+#include "Cromosoma.h"
+#include "Generacion.h"
+#include "Serializacion.h"
+
+// Punto de control de una corrida: todo lo necesario para continuarla exactamente donde quedo. Los flujos
+// aleatorios dependen solo de la semilla, la generacion y el indice de cada tarea, asi que basta con guardar
+// la semilla, el contador de generaciones y las filas de la poblacion. La cache y los estados por mes no se
+// guardan: solo ahorran trabajo y se reconstruyen dando los mismos valores (ver cargar).
+//
+//   char[8] "GAPUNTO1", uint32 version, uint32 relleno
+//   uint64 semilla, uint64 numeroGeneracion
+//   int32 tamanoPoblacion, numeroCultivos, meses, filas; double tasaMutacion, tasaCruce
+//   mejor cromosoma de la corrida (como serializarCromosoma)
+//   filas veces: genes y cultivoPlantado (dimension dobles cada uno) y double valorObjetivo
+//   uint64 suma de verificacion de todo lo anterior
+//
+// Guardar copia el estado a un buffer y lo escribe un hilo aparte en 'ruta.tmp', que luego reemplaza a 'ruta'
+// de una vez: la generacion siguiente no espera al disco y una interrupcion nunca deja un archivo a medias
+class PuntoControl {
+   public:
+    static const uint32_t VERSION = 1;
+
+    explicit PuntoControl(const string& ruta) : ruta(ruta), pendiente(false), terminar(false), correcto(true) {
+        escritor = thread(&PuntoControl::bucleEscritor, this);
+    }
+
+    ~PuntoControl() {
+        {
+            lock_guard<mutex> bloqueo(mutexEscritura);
+            terminar = true;
+        }
+        cvEscritura.notify_all();
+        escritor.join();
+    }
+
+    PuntoControl(const PuntoControl&) = delete;
+    PuntoControl& operator=(const PuntoControl&) = delete;
+
+    // Copiar el estado de la corrida y encargar su escritura. Solo espera si la escritura anterior sigue en
+    // curso. Devuelve false si alguna escritura anterior fallo
+    bool guardar(const Generacion& generacion, const Cromosoma& mejorCromosoma, int numeroCultivos, int meses) {
+        unique_lock<mutex> bloqueo(mutexEscritura);
+        cvTerminado.wait(bloqueo, [this] { return !pendiente; });
+        serializar(buffer, generacion, mejorCromosoma, numeroCultivos, meses);
+        pendiente = true;
+        bloqueo.unlock();
+        cvEscritura.notify_one();
+        return correcto;
+    }
+
+    // Esperar a que termine la ultima escritura; devuelve false si alguna fallo
+    bool esperar() {
+        unique_lock<mutex> bloqueo(mutexEscritura);
+        cvTerminado.wait(bloqueo, [this] { return !pendiente; });
+        return correcto;
+    }
+
+    // Restaurar la corrida guardada en 'ruta'. La poblacion, la semilla y el contador de generaciones de
+    // 'generacion' quedan como al guardar; devuelve false y el motivo en 'error' si el archivo no sirve. Las filas
+    // quedan sin estados por mes: hay que reevaluarlas (inicializarValoresObjetivo) antes de seguir la corrida
+    static bool cargar(const string& ruta, Generacion& generacion, Cromosoma& mejorCromosoma, int& numeroCultivos, int& meses,
+                       string& error) {
+        vector<char> datos;
+        FILE* archivo = fopen(ruta.c_str(), "rb");
+        if (archivo == nullptr) {
+            error = "no se pudo abrir " + ruta;
+            return false;
+        }
+        char bloque[1 << 16];
+        size_t leidos;
+        while ((leidos = fread(bloque, 1, sizeof(bloque), archivo)) > 0) datos.insert(datos.end(), bloque, bloque + leidos);
+        fclose(archivo);
+
+        error = ruta + " no es un punto de control valido (version " + to_string(VERSION) + ")";
+        uint64_t suma = 0;
+        if (datos.size() < LONGITUD_MARCA + sizeof(suma) || memcmp(datos.data(), marca(), LONGITUD_MARCA) != 0) return false;
+        memcpy(&suma, datos.data() + datos.size() - sizeof(suma), sizeof(suma));
+        if (suma != sumaVerificacion(datos.data(), datos.size() - sizeof(suma))) return false;
+
+        const char* cursor = datos.data() + LONGITUD_MARCA;
+        const char* fin = datos.data() + datos.size() - sizeof(suma);
+        uint32_t version = 0, relleno = 0;
+        uint64_t semilla = 0, numeroGeneracion = 0;
+        int32_t tamanoPoblacion = 0, cultivos = 0, mesesGuardados = 0, filas = 0;
+        double tasaMutacion = 0.0, tasaCruce = 0.0;
+        if (!leerValor(cursor, fin, version) || version != VERSION || !leerValor(cursor, fin, relleno) ||
+            !leerValor(cursor, fin, semilla) || !leerValor(cursor, fin, numeroGeneracion) ||
+            !leerValor(cursor, fin, tamanoPoblacion) || !leerValor(cursor, fin, cultivos) || !leerValor(cursor, fin, mesesGuardados) ||
+            !leerValor(cursor, fin, filas) || !leerValor(cursor, fin, tasaMutacion) || !leerValor(cursor, fin, tasaCruce) ||
+            !deserializarCromosoma(cursor, fin, mejorCromosoma) || cultivos <= 0 || mesesGuardados <= 0 || filas < 0) {
+            return false;
+        }
+        int dimension = cultivos * mesesGuardados;
+        size_t bytesFila = (2 * static_cast<size_t>(dimension) + 1) * sizeof(double);
+        if (static_cast<size_t>(fin - cursor) != filas * bytesFila || mejorCromosoma.genes.size() != static_cast<size_t>(dimension)) return false;
+
+        Poblacion& poblacion = generacion.poblacion;
+        poblacion.limpiar();
+        poblacion.redimensionar(filas, dimension);
+        for (int i = 0; i < filas; ++i) {
+            VistaCromosoma fila = poblacion[i];
+            leerGenes(cursor, fila.genes);
+            leerGenes(cursor + dimension * sizeof(double), fila.cultivoPlantado);
+            cursor += 2 * dimension * sizeof(double);
+            leerValor(cursor, fin, poblacion.valoresObjetivo[i]);
+            poblacion.estadoValido[i] = 0;
+        }
+        generacion.tamanoPoblacion = tamanoPoblacion;
+        generacion.tasaMutacion = tasaMutacion;
+        generacion.tasaCruce = tasaCruce;
+        generacion.semilla = semilla;
+        generacion.numeroGeneracion = static_cast<unsigned long>(numeroGeneracion);
+        numeroCultivos = cultivos;
+        meses = mesesGuardados;
+        error.clear();
+        return true;
+    }
+
+   private:
+    static const size_t LONGITUD_MARCA = 8;
+
+    static const char* marca() { return "GAPUNTO1"; }
+
+    string ruta;
+    vector<char> buffer;           // Estado copiado por guardar, que el escritor vuelca al disco
+    bool pendiente;                // Hay un buffer esperando o en escritura
+    bool terminar;
+    bool correcto;                 // Si todas las escrituras han tenido exito
+    thread escritor;
+    mutex mutexEscritura;
+    condition_variable cvEscritura;
+    condition_variable cvTerminado;
+
+    // FNV-1a de 64 bits sobre palabras de 8 bytes (y los bytes sobrantes al final)
+    static uint64_t sumaVerificacion(const char* datos, size_t bytes) {
+        uint64_t suma = 0xCBF29CE484222325ULL;
+        size_t palabras = bytes / sizeof(uint64_t);
+        for (size_t i = 0; i < palabras; ++i) {
+            uint64_t palabra;
+            memcpy(&palabra, datos + i * sizeof(uint64_t), sizeof(palabra));
+            suma = (suma ^ palabra) * 0x100000001B3ULL;
+        }
+        for (size_t i = palabras * sizeof(uint64_t); i < bytes; ++i) {
+            suma = (suma ^ static_cast<unsigned char>(datos[i])) * 0x100000001B3ULL;
+        }
+        return suma;
+    }
+
+    static void serializar(vector<char>& datos, const Generacion& generacion, const Cromosoma& mejorCromosoma, int numeroCultivos,
+                           int meses) {
+        const Poblacion& poblacion = generacion.poblacion;
+        int dimension = poblacion.obtenerDimension();
+        datos.clear();
+        datos.reserve(LONGITUD_MARCA + 64 + (poblacion.size() + 1) * (2 * dimension + 2) * sizeof(double) + 16);
+        datos.insert(datos.end(), marca(), marca() + LONGITUD_MARCA);
+        escribirValor(datos, static_cast<uint32_t>(VERSION));
+        escribirValor(datos, static_cast<uint32_t>(0));
+        escribirValor(datos, generacion.semilla);
+        escribirValor(datos, static_cast<uint64_t>(generacion.numeroGeneracion));
+        escribirValor(datos, static_cast<int32_t>(generacion.tamanoPoblacion));
+        escribirValor(datos, static_cast<int32_t>(numeroCultivos));
+        escribirValor(datos, static_cast<int32_t>(meses));
+        escribirValor(datos, static_cast<int32_t>(poblacion.size()));
+        escribirValor(datos, generacion.tasaMutacion);
+        escribirValor(datos, generacion.tasaCruce);
+        serializarCromosoma(datos, mejorCromosoma);
+        for (int i = 0; i < poblacion.size(); ++i) {
+            VistaConstCromosoma fila = poblacion[i];
+            escribirGenes(datos, fila.genes);
+            escribirGenes(datos, fila.cultivoPlantado);
+            escribirValor(datos, poblacion.valoresObjetivo[i]);
+        }
+        escribirValor(datos, sumaVerificacion(datos.data(), datos.size()));
+    }
+
+    void bucleEscritor() {
+        unique_lock<mutex> bloqueo(mutexEscritura);
+        while (true) {
+            cvEscritura.wait(bloqueo, [this] { return pendiente || terminar; });
+            if (!pendiente) return;
+
+            // El buffer no cambia mientras 'pendiente' siga activo, asi que se escribe sin el candado
+            bloqueo.unlock();
+            bool escrito = escribirArchivo();
+            bloqueo.lock();
+            correcto = correcto && escrito;
+            pendiente = false;
+            cvTerminado.notify_all();
+        }
+    }
+
+    bool escribirArchivo() const {
+        string temporal = ruta + ".tmp";
+        FILE* archivo = fopen(temporal.c_str(), "wb");
+        if (archivo == nullptr) return false;
+        bool escrito = fwrite(buffer.data(), 1, buffer.size(), archivo) == buffer.size() && fflush(archivo) == 0;
+#ifndef _WIN32
+        escrito = escrito && fsync(fileno(archivo)) == 0;  // Que el reemplazo nunca apunte a datos sin llegar al disco
+#endif
+        escrito = fclose(archivo) == 0 && escrito;
+#ifdef _WIN32
+        remove(ruta.c_str());  // En Windows rename no reemplaza un archivo existente
+#endif
+        return escrito && rename(temporal.c_str(), ruta.c_str()) == 0;
+    }
+};
+
+#endif /* PUNTOCONTROL_H */
@@ -0,0 +1,155 @@
+#ifndef SELECCION_H
+#define SELECCION_H
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+#include "Aleatorio.h"
+
+enum TipoSeleccion {
+    SELECCION_UNIFORME,  // Cualquier individuo con la misma probabilidad, sin mirar su valor objetivo
+    SELECCION_TORNEO,    // El mejor de tamanoTorneo individuos tomados al azar
+    SELECCION_RANKING,   // Probabilidad lineal segun la posicion en el orden por valor objetivo
+    SELECCION_SUS        // Muestreo universal estocastico sobre los mismos pesos del ranking
+};
+
+static const char* const NOMBRES_SELECCION[] = {"uniforme", "torneo", "ranking", "sus"};
+
+inline const char* nombreSeleccion(TipoSeleccion tipo) {
+    return NOMBRES_SELECCION[tipo];
+}
+
+// Interpretar el nombre de un operador ("uniforme", "torneo", "ranking" o "sus")
+inline bool interpretarSeleccion(const char* nombre, TipoSeleccion& tipo) {
+    for (int t = 0; t < 4; ++t) {
+        if (strcmp(nombre, NOMBRES_SELECCION[t]) == 0) {
+            tipo = static_cast<TipoSeleccion>(t);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Operador de seleccion de padres. preparar() se llama una vez por generacion, en un solo hilo, y deja listas
+// las tablas que dependen de los valores objetivo; despues cada pareja se elige en O(1) (O(k) con torneo)
+// desde cualquier hilo, con el generador propio de su tarea. Se devuelven indices, nunca copias
+class OperadorSeleccion {
+   public:
+    TipoSeleccion tipo = SELECCION_UNIFORME;
+    int tamanoTorneo = 2;         // Participantes de cada torneo
+    double presionRanking = 1.7;  // Hijos esperados del mejor con ranking lineal, entre 1 (uniforme) y 2
+
+    // Preparar la generacion: 'valores' son los valores objetivo de los 'tamano' individuos que pueden ser
+    // padres y se elegiran 'parejas' parejas. 'gen' es un flujo exclusivo de la generacion (solo lo usa SUS)
+    void preparar(const double* valoresNuevos, int tamanoNuevo, int parejas, GeneradorAleatorio gen) {
+        valores = valoresNuevos;
+        tamano = tamanoNuevo;
+        if (tipo == SELECCION_RANKING || tipo == SELECCION_SUS) calcularPesosRanking();
+        if (tipo == SELECCION_RANKING) construirAlias();
+        if (tipo == SELECCION_SUS) muestrearUniversal(2 * parejas, gen);
+    }
+
+    // Padres de la pareja 'pareja' (0 <= pareja < parejas)
+    pair<int, int> elegirPadres(int pareja, GeneradorAleatorio& gen) const {
+        switch (tipo) {
+            case SELECCION_TORNEO:
+                return make_pair(torneo(gen), torneo(gen));
+            case SELECCION_RANKING:
+                return make_pair(muestraAlias(gen), muestraAlias(gen));
+            case SELECCION_SUS:
+                return make_pair(elegidos[2 * pareja], elegidos[2 * pareja + 1]);
+            default: {
+                uniform_int_distribution<> dist(0, tamano - 1);
+                int padre1 = dist(gen);
+                int padre2 = dist(gen);
+                return make_pair(padre1, padre2);
+            }
+        }
+    }
+
+   private:
+    const double* valores = nullptr;
+    int tamano = 0;
+    vector<int> orden;                // Indices de mejor a peor valor objetivo
+    vector<double> pesos;             // Peso de seleccion de cada individuo (suman 1)
+    vector<double> probabilidadAlias; // Tabla de alias de Vose sobre 'pesos'
+    vector<int> alias;
+    vector<int> grandes;              // Pila de trabajo al construir la tabla de alias
+    vector<int> elegidos;             // Padres ya muestreados por SUS, barajados, dos por pareja
+
+    int torneo(GeneradorAleatorio& gen) const {
+        int ganador = gen.enteroMenorQue(tamano);
+        for (int k = 1; k < tamanoTorneo; ++k) {
+            int rival = gen.enteroMenorQue(tamano);
+            if (valores[rival] > valores[ganador] || (valores[rival] == valores[ganador] && rival < ganador)) ganador = rival;
+        }
+        return ganador;
+    }
+
+    int muestraAlias(GeneradorAleatorio& gen) const {
+        int columna = gen.enteroMenorQue(tamano);
+        return gen.uniforme() < probabilidadAlias[columna] ? columna : alias[columna];
+    }
+
+    // Ranking lineal: el de posicion r (0 = mejor) pesa (s - (2s - 2) r / (n - 1)) / n
+    void calcularPesosRanking() {
+        orden.resize(tamano);
+        for (int i = 0; i < tamano; ++i) orden[i] = i;
+        const double* v = valores;
+        sort(orden.begin(), orden.end(), [v](int a, int b) { return v[a] > v[b] || (v[a] == v[b] && a < b); });
+        double s = min(2.0, max(1.0, presionRanking));
+        pesos.resize(tamano);
+        for (int r = 0; r < tamano; ++r) {
+            double peso = tamano > 1 ? (s - (2.0 * s - 2.0) * r / (tamano - 1)) / tamano : 1.0;
+            pesos[orden[r]] = peso;
+        }
+    }
+
+    // Metodo de alias de Vose: cada columna guarda una probabilidad y un segundo individuo
+    void construirAlias() {
+        probabilidadAlias.resize(tamano);
+        alias.resize(tamano);
+        vector<int>& pequenos = orden;  // 'orden' ya no hace falta: se reutiliza como pila
+        grandes.clear();
+        pequenos.clear();
+        for (int i = 0; i < tamano; ++i) {
+            probabilidadAlias[i] = pesos[i] * tamano;
+            alias[i] = i;
+            (probabilidadAlias[i] < 1.0 ? pequenos : grandes).push_back(i);
+        }
+        while (!pequenos.empty() && !grandes.empty()) {
+            int pequeno = pequenos.back(), grande = grandes.back();
+            pequenos.pop_back();
+            alias[pequeno] = grande;
+            probabilidadAlias[grande] -= 1.0 - probabilidadAlias[pequeno];
+            if (probabilidadAlias[grande] < 1.0) {
+                grandes.pop_back();
+                pequenos.push_back(grande);
+            }
+        }
+        for (int i : grandes) probabilidadAlias[i] = 1.0;
+        for (int i : pequenos) probabilidadAlias[i] = 1.0;  // Restos de redondeo
+    }
+
+    // SUS: 'cantidad' punteros equiespaciados sobre los pesos acumulados con un solo desplazamiento al azar,
+    // luego barajados para formar las parejas
+    void muestrearUniversal(int cantidad, GeneradorAleatorio& gen) {
+        elegidos.resize(cantidad);
+        double paso = 1.0 / cantidad;
+        double puntero = gen.uniforme() * paso;
+        double acumulado = pesos.empty() ? 0.0 : pesos[0];
+        int individuo = 0;
+        for (int k = 0; k < cantidad; ++k, puntero += paso) {
+            while (puntero >= acumulado && individuo < tamano - 1) acumulado += pesos[++individuo];
+            elegidos[k] = individuo;
+        }
+        for (int k = cantidad - 1; k > 0; --k) swap(elegidos[k], elegidos[gen.enteroMenorQue(k + 1)]);
+    }
+};
+
+#endif /* SELECCION_H */
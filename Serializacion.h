@@ -0,0 +1,76 @@
+#ifndef SERIALIZACION_H
+#define SERIALIZACION_H
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+using namespace std;
+
+#include "Cromosoma.h"
+
+// Escritura y lectura binaria compacta de valores y cromosomas. Los enteros y dobles se copian con el orden
+// de bytes del equipo: todos los nodos que intercambian datos deben compartirlo (x86-64, little endian)
+
+template <class T>
+inline void escribirValor(vector<char>& buffer, const T& valor) {
+    const char* bytes = reinterpret_cast<const char*>(&valor);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+template <class T>
+inline bool leerValor(const char*& cursor, const char* fin, T& valor) {
+    if (static_cast<size_t>(fin - cursor) < sizeof(T)) return false;
+    memcpy(&valor, cursor, sizeof(T));
+    cursor += sizeof(T);
+    return true;
+}
+
+// Genes en el formato de los archivos y mensajes, que siempre es double aunque TipoGen sea float
+inline void escribirGenes(vector<char>& buffer, Fila<const TipoGen> genes) {
+    size_t inicio = buffer.size();
+    buffer.resize(inicio + genes.size() * sizeof(double));
+    for (size_t i = 0; i < genes.size(); ++i) {
+        double valor = genes[i];
+        memcpy(buffer.data() + inicio + i * sizeof(double), &valor, sizeof(double));
+    }
+}
+
+// Leer genes escritos por escribirGenes; el llamador ya comprobo que hay genes.size() dobles
+inline void leerGenes(const char* origen, Fila<TipoGen> genes) {
+    for (size_t i = 0; i < genes.size(); ++i) {
+        double valor;
+        memcpy(&valor, origen + i * sizeof(double), sizeof(double));
+        genes[i] = static_cast<TipoGen>(valor);
+    }
+}
+
+// Cromosoma: uint32 dimension, genes, cultivoPlantado (dimension dobles cada uno) y double valorObjetivo
+inline void serializarCromosoma(vector<char>& buffer, VistaConstCromosoma cromosoma, double valorObjetivo) {
+    uint32_t dimension = static_cast<uint32_t>(cromosoma.genes.size());
+    escribirValor(buffer, dimension);
+    escribirGenes(buffer, cromosoma.genes);
+    escribirGenes(buffer, cromosoma.cultivoPlantado);
+    escribirValor(buffer, valorObjetivo);
+}
+
+inline void serializarCromosoma(vector<char>& buffer, const Cromosoma& cromosoma) {
+    serializarCromosoma(buffer, cromosoma.vista(), cromosoma.valorObjetivo);
+}
+
+// Leer un cromosoma escrito por serializarCromosoma; devuelve false si los datos estan incompletos
+inline bool deserializarCromosoma(const char*& cursor, const char* fin, Cromosoma& cromosoma) {
+    uint32_t dimension = 0;
+    if (!leerValor(cursor, fin, dimension)) return false;
+    size_t bytes = static_cast<size_t>(dimension) * sizeof(double);
+    if (static_cast<size_t>(fin - cursor) < 2 * bytes + sizeof(double)) return false;
+    cromosoma.genes.resize(dimension);
+    cromosoma.cultivoPlantado.resize(dimension);
+    VistaCromosoma vista = cromosoma.vista();
+    leerGenes(cursor, vista.genes);
+    leerGenes(cursor + bytes, vista.cultivoPlantado);
+    cursor += 2 * bytes;
+    return leerValor(cursor, fin, cromosoma.valorObjetivo);
+}
+
+#endif /* SERIALIZACION_H */
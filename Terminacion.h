@@ -0,0 +1,123 @@
+#ifndef TERMINACION_H
+#define TERMINACION_H
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <ostream>
+
+using namespace std;
+
+#include "Poblacion.h"
+
+// Resumen de la poblacion en una generacion, calculado en una sola pasada y sin copiar cromosomas
+struct EstadisticasGeneracion {
+    int generacion = 0;
+    int indiceMejor = 0;   // Fila del mejor individuo (la primera, si hay empate)
+    double mejor = 0.0;    // Mayor valor objetivo
+    double media = 0.0;    // Valor objetivo medio
+    double peor = 0.0;     // Menor valor objetivo
+    double segundos = 0.0; // Tiempo transcurrido desde el inicio de la corrida
+
+    void calcular(const Poblacion& poblacion, int numeroGeneracion) {
+        calcular(poblacion.valoresObjetivo.data(), poblacion.size(), numeroGeneracion);
+    }
+
+    // Igual, sobre los valores objetivo de 'tamano' individuos
+    void calcular(const double* valores, int tamano, int numeroGeneracion) {
+        generacion = numeroGeneracion;
+        indiceMejor = 0;
+        double suma = 0.0;
+        mejor = peor = tamano > 0 ? valores[0] : 0.0;
+        for (int i = 0; i < tamano; ++i) {
+            double valor = valores[i];
+            suma += valor;
+            if (valor > mejor) {
+                mejor = valor;
+                indiceMejor = i;
+            }
+            peor = min(peor, valor);
+        }
+        media = tamano > 0 ? suma / tamano : 0.0;
+    }
+
+    static void escribirCabecera(ostream& salida) {
+        salida << "generacion,mejor,media,peor,segundos" << endl;
+    }
+
+    void escribir(ostream& salida) const {
+        salida << generacion << "," << mejor << "," << media << "," << peor << "," << segundos << endl;
+    }
+};
+
+enum MotivoTerminacion {
+    SIN_TERMINAR,
+    TERMINO_GENERACIONES,   // Se llego al maximo de generaciones
+    TERMINO_ESTANCAMIENTO,  // Ni el mejor ni la media mejoraron en generacionesSinMejora generaciones
+    TERMINO_TIEMPO,         // Se agoto el tiempo de la corrida
+    TERMINO_META            // El mejor alcanzo el valor objetivo buscado
+};
+
+inline const char* nombreMotivo(MotivoTerminacion motivo) {
+    switch (motivo) {
+        case TERMINO_GENERACIONES: return "maximo de generaciones";
+        case TERMINO_ESTANCAMIENTO: return "estancamiento";
+        case TERMINO_TIEMPO: return "tiempo agotado";
+        case TERMINO_META: return "valor objetivo alcanzado";
+        default: return "sin terminar";
+    }
+}
+
+// Criterios para detener una corrida antes del maximo de generaciones. Cada criterio se desactiva con su
+// valor por omision. Se consulta una vez por generacion con las estadisticas de la poblacion
+class CriterioTerminacion {
+   public:
+    int maximoGeneraciones = 100;                                // Limite de generaciones
+    int generacionesSinMejora = 0;                               // Generaciones seguidas sin mejora para parar (0 = sin limite)
+    double toleranciaMejora = 1e-9;                              // Aumento minimo que cuenta como mejora
+    double segundosMaximos = 0.0;                                // Tiempo de la corrida (0 = sin limite)
+    double valorMeta = numeric_limits<double>::infinity();      // Parar al alcanzar este valor objetivo
+
+    MotivoTerminacion motivo = SIN_TERMINAR;
+
+    // Empezar a medir una corrida; las generaciones ya hechas (al reanudar) cuentan para el maximo
+    void iniciar() {
+        inicio = chrono::steady_clock::now();
+        motivo = SIN_TERMINAR;
+        mejorVisto = -numeric_limits<double>::infinity();
+        mejorMedia = -numeric_limits<double>::infinity();
+        generacionesEstancadas = 0;
+        ultimaGeneracion = 0;
+    }
+
+    double segundosTranscurridos() const {
+        return chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+    }
+
+    // Registrar las estadisticas de una generacion (completando su tiempo) y decidir si la corrida sigue. Se
+    // puede consultar cada varias generaciones (el modelo de islas lo hace entre migraciones): el estancamiento
+    // cuenta las generaciones transcurridas desde la consulta anterior
+    bool continuar(EstadisticasGeneracion& estadisticas) {
+        estadisticas.segundos = segundosTranscurridos();
+        bool mejora = estadisticas.mejor > mejorVisto + toleranciaMejora || estadisticas.media > mejorMedia + toleranciaMejora;
+        mejorVisto = max(mejorVisto, estadisticas.mejor);
+        mejorMedia = max(mejorMedia, estadisticas.media);
+        generacionesEstancadas = mejora ? 0 : generacionesEstancadas + (estadisticas.generacion - ultimaGeneracion);
+        ultimaGeneracion = estadisticas.generacion;
+
+        if (estadisticas.mejor >= valorMeta) motivo = TERMINO_META;
+        else if (generacionesSinMejora > 0 && generacionesEstancadas >= generacionesSinMejora) motivo = TERMINO_ESTANCAMIENTO;
+        else if (segundosMaximos > 0.0 && estadisticas.segundos >= segundosMaximos) motivo = TERMINO_TIEMPO;
+        else if (estadisticas.generacion >= maximoGeneraciones) motivo = TERMINO_GENERACIONES;
+        return motivo == SIN_TERMINAR;
+    }
+
+   private:
+    chrono::steady_clock::time_point inicio;
+    double mejorVisto = 0.0;          // Mejor valor visto en la corrida
+    double mejorMedia = 0.0;          // Mejor media vista en la corrida
+    int generacionesEstancadas = 0;   // Generaciones seguidas sin mejora
+    int ultimaGeneracion = 0;         // Generacion de la consulta anterior
+};
+
+#endif /* TERMINACION_H */
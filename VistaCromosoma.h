@@ -0,0 +1,73 @@
+#ifndef VISTACROMOSOMA_H
+#define VISTACROMOSOMA_H
+
+#include <algorithm>
+#include <cstddef>
+
+using namespace std;
+
+// Fila de una matriz: puntero a datos contiguos y su longitud. Se usa como un vector sin ser duenio de la memoria
+template <class T>
+class Fila {
+   public:
+    Fila() : datos(nullptr), longitud(0) {}
+
+    Fila(T* datos, size_t longitud) : datos(datos), longitud(longitud) {}
+
+    // Permite pasar una fila modificable donde se espera una de solo lectura
+    template <class U>
+    Fila(const Fila<U>& otra) : datos(otra.data()), longitud(otra.size()) {}
+
+    T& operator[](size_t i) const { return datos[i]; }
+    size_t size() const { return longitud; }
+    bool empty() const { return longitud == 0; }
+    T* data() const { return datos; }
+    T* begin() const { return datos; }
+    T* end() const { return datos + longitud; }
+
+   private:
+    T* datos;
+    size_t longitud;
+};
+
+// Vista ligera de un cromosoma: genes y cultivoPlantado de un individuo, ya sea de un Cromosoma
+// o de una fila de la matriz contigua de la Poblacion. Copiarla no copia los genes
+template <class T>
+class VistaCromosomaT {
+   public:
+    Fila<T> genes;            // Area ocupada por cultivo y mes
+    Fila<T> cultivoPlantado;  // Area plantada por cultivo en su mes de siembra
+
+    VistaCromosomaT() {}
+
+    VistaCromosomaT(Fila<T> genes, Fila<T> cultivoPlantado) : genes(genes), cultivoPlantado(cultivoPlantado) {}
+
+    template <class U>
+    VistaCromosomaT(const VistaCromosomaT<U>& otra) : genes(otra.genes), cultivoPlantado(otra.cultivoPlantado) {}
+
+    // Copiar el contenido de otra vista de la misma dimension
+    template <class U>
+    void copiarDe(const VistaCromosomaT<U>& origen) const {
+        copy(origen.genes.begin(), origen.genes.end(), genes.begin());
+        copy(origen.cultivoPlantado.begin(), origen.cultivoPlantado.end(), cultivoPlantado.begin());
+    }
+
+    void limpiar() const {
+        fill(genes.begin(), genes.end(), T());
+        fill(cultivoPlantado.begin(), cultivoPlantado.end(), T());
+    }
+};
+
+// Tipo con que se guardan los genes en la poblacion y en los cromosomas. Con -DGA_PRECISION_SIMPLE se
+// guardan en float: la poblacion ocupa la mitad y cada linea de cache trae el doble de genes, mientras
+// los acumuladores de la funcion objetivo siguen en double
+#ifdef GA_PRECISION_SIMPLE
+typedef float TipoGen;
+#else
+typedef double TipoGen;
+#endif
+
+typedef VistaCromosomaT<TipoGen> VistaCromosoma;
+typedef VistaCromosomaT<const TipoGen> VistaConstCromosoma;
+
+#endif /* VISTACROMOSOMA_H */
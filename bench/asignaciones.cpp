@@ -0,0 +1,126 @@
+/*
+ * Comprobacion de que el ciclo de generaciones no asigna memoria dinamica en regimen estable.
+ * Se compila con -DGA_INSTRUMENTACION y reemplaza operator new por el contador de Instrumentacion.h
+ * (GA_CONTAR_ASIGNACIONES). Para cada problema corre unas generaciones de calentamiento, en las que los buffers
+ * reutilizables (hijos, sobrevivientes, arenas de los hilos, tablas del evaluador) alcanzan su tamano final, y
+ * despues cuenta las asignaciones de las generaciones siguientes. Termina con error si alguna generacion asigno.
+ * El registro de instrumentacion de cada hilo se crea al primer evento del hilo; se fuerza antes de medir para que
+ * no cuente como asignacion de la generacion en la que un hilo del pool recibe trabajo por primera vez.
+ *
+ * Uso: asignaciones [--threads N] [--calentamiento N] [--generaciones N]
+ */
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+#include "Generacion.h"
+#include "Instrumentacion.h"
+#include "PoolHilos.h"
+
+GA_CONTAR_ASIGNACIONES()
+
+// Mismo escenario que bench/benchmark.cpp: repite los valores por defecto de Cultivacion (5 cultivos, 8 meses)
+static Cultivacion crearEscenario(int numeroCultivos, int meses) {
+    Cultivacion base;
+    Cultivacion escenario;
+    int cultivosBase = static_cast<int>(base.mesesCultivo.size());
+    int mesesBase = static_cast<int>(base.aguaInicialDisponible.size());
+    escenario.mesesCultivo.resize(numeroCultivos);
+    escenario.requerimientoAgua.resize(numeroCultivos);
+    escenario.reduccionRendimiento.resize(numeroCultivos);
+    escenario.salinidadCritica.resize(numeroCultivos);
+    escenario.maxCosechaPorArea.resize(numeroCultivos);
+    escenario.cambioSalinidadPorArea.resize(numeroCultivos);
+    escenario.susceptibilidadAgua.resize(numeroCultivos);
+    for (int c = 0; c < numeroCultivos; ++c) {
+        int b = c % cultivosBase;
+        escenario.mesesCultivo[c] = base.mesesCultivo[b];
+        escenario.requerimientoAgua[c] = base.requerimientoAgua[b];
+        escenario.reduccionRendimiento[c] = base.reduccionRendimiento[b];
+        escenario.salinidadCritica[c] = base.salinidadCritica[b];
+        escenario.maxCosechaPorArea[c] = base.maxCosechaPorArea[b];
+        escenario.cambioSalinidadPorArea[c] = base.cambioSalinidadPorArea[b];
+        escenario.susceptibilidadAgua[c] = base.susceptibilidadAgua[b];
+    }
+    escenario.aguaInicialDisponible.resize(meses);
+    escenario.cultivable.resize(numeroCultivos * meses);
+    for (int mes = 0; mes < meses; ++mes) {
+        escenario.aguaInicialDisponible[mes] = base.aguaInicialDisponible[mes % mesesBase];
+        for (int c = 0; c < numeroCultivos; ++c) {
+            escenario.cultivable[c + numeroCultivos * mes] = base.cultivable[c % cultivosBase + cultivosBase * (mes % mesesBase)];
+        }
+    }
+    return escenario;
+}
+
+// Crear el registro de instrumentacion de todos los hilos del pool: cada tarea espera a las demas, asi que cada
+// una corre en un hilo distinto
+static void registrarHilos(PoolHilos& poolHilos) {
+    atomic<int> llegados(0);
+    int numeroHilos = poolHilos.numeroHilos();
+    poolHilos.paraCada(numeroHilos, [&](int, int) {
+        Instrumentacion::global().hiloActual();
+        llegados.fetch_add(1);
+        while (llegados.load() < numeroHilos) this_thread::yield();
+    });
+}
+
+// Asignaciones hechas durante las generaciones medidas, despues del calentamiento
+static uint64_t contarAsignaciones(int numeroCultivos, int meses, int tamanoPoblacion, int calentamiento, int numeroGeneraciones,
+                                   PoolHilos* poolHilos) {
+    Cultivacion cultivacion = crearEscenario(numeroCultivos, meses);
+    Generacion generacion(0, numeroCultivos * meses);
+    generacion.tamanoPoblacion = tamanoPoblacion;
+    generacion.poolHilos = poolHilos;
+    generacion.semilla = 42;
+
+    generacion.inicializarCromosomas(numeroCultivos, meses, cultivacion);
+    generacion.inicializarValoresObjetivo(numeroCultivos, meses, cultivacion);
+    for (int i = 0; i < calentamiento; ++i) generacion.obtenerNuevaGeneracion(tamanoPoblacion, numeroCultivos, meses, cultivacion);
+
+    uint64_t antes = contadorAsignaciones().load();
+    for (int i = 0; i < numeroGeneraciones; ++i) generacion.obtenerNuevaGeneracion(tamanoPoblacion, numeroCultivos, meses, cultivacion);
+    return contadorAsignaciones().load() - antes;
+}
+
+int main(int argc, char* argv[]) {
+    int numeroHilos = 0;           // 0 = todos los nucleos
+    int calentamiento = 20;        // Generaciones sin medir
+    int numeroGeneraciones = 100;  // Generaciones medidas
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            numeroHilos = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--calentamiento") == 0 && i + 1 < argc) {
+            calentamiento = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--generaciones") == 0 && i + 1 < argc) {
+            numeroGeneraciones = atoi(argv[++i]);
+        } else {
+            cerr << "Uso: " << argv[0] << " [--threads N] [--calentamiento N] [--generaciones N]" << endl;
+            return 1;
+        }
+    }
+
+    const int PROBLEMAS[][2] = {{5, 8}, {12, 24}, {40, 60}};  // Cultivos x meses
+    const int TAMANO_POBLACION = 200;
+
+    PoolHilos poolHilos(numeroHilos);
+    registrarHilos(poolHilos);
+    bool correcto = true;
+    cout << "Asignaciones en " << numeroGeneraciones << " generaciones tras " << calentamiento << " de calentamiento, poblacion "
+         << TAMANO_POBLACION << endl;
+    for (const int* problema : PROBLEMAS) {
+        uint64_t serie = contarAsignaciones(problema[0], problema[1], TAMANO_POBLACION, calentamiento, numeroGeneraciones, nullptr);
+        uint64_t paralelo = contarAsignaciones(problema[0], problema[1], TAMANO_POBLACION, calentamiento, numeroGeneraciones, &poolHilos);
+        correcto = correcto && serie == 0 && paralelo == 0;
+        cout << "  " << problema[0] << "x" << problema[1] << ": " << serie << " en serie, " << paralelo << " con "
+             << poolHilos.numeroHilos() << " hilos" << (serie == 0 && paralelo == 0 ? "" : "  <- FALLA") << endl;
+    }
+    return correcto ? 0 : 1;
+}
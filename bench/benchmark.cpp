@@ -0,0 +1,455 @@
+/*
+ * Benchmarks del algoritmo genetico: microbenchmarks de cada operador, inicializacion de la poblacion con cada
+ * vez menos agua, generaciones por segundo de punta a punta para varios tamanos de poblacion y de problema, y
+ * representacion densa contra dispersa en problemas grandes.
+ * El resultado se escribe en JSON para poder comparar corridas entre versiones; el avance se informa por stderr.
+ *
+ * Uso: benchmark [--threads N] [--seed S] [--tiempo SEG] [--maximo N] [--rapido] [--salida ARCHIVO]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+#include "Generacion.h"
+#include "GeneracionDispersa.h"
+#include "PoolHilos.h"
+
+typedef chrono::steady_clock Reloj;
+
+static double segundosDesde(Reloj::time_point inicio) {
+    return chrono::duration<double>(Reloj::now() - inicio).count();
+}
+
+struct Medicion {
+    string nombre;
+    int cultivos;
+    int meses;
+    long iteraciones;
+    double nsPorOperacion;
+};
+
+struct MedicionGeneraciones {
+    int cultivos;
+    int meses;
+    int tamanoPoblacion;
+    long generaciones;
+    double segundos;
+    double generacionesPorSegundo;
+    double mejorValorObjetivo;
+};
+
+struct MedicionInicializacion {
+    const char* muestreo;
+    double factorAgua;
+    long cromosomas;
+    double nsPorCromosoma;
+};
+
+struct MedicionRepresentacion {
+    const char* representacion;
+    int cultivos;
+    int meses;
+    int tamanoPoblacion;
+    long generaciones;
+    double generacionesPorSegundo;
+    double bytesPorIndividuo;  // Genes y cultivoPlantado de un individuo (densa) o su plan (dispersa), en promedio
+    double mejorValorObjetivo;
+};
+
+// Escenario de numeroCultivos x meses que repite los valores por defecto de Cultivacion (5 cultivos, 8 meses)
+static Cultivacion crearEscenario(int numeroCultivos, int meses) {
+    Cultivacion base;
+    Cultivacion escenario;
+    int cultivosBase = static_cast<int>(base.mesesCultivo.size());
+    int mesesBase = static_cast<int>(base.aguaInicialDisponible.size());
+    escenario.mesesCultivo.resize(numeroCultivos);
+    escenario.requerimientoAgua.resize(numeroCultivos);
+    escenario.reduccionRendimiento.resize(numeroCultivos);
+    escenario.salinidadCritica.resize(numeroCultivos);
+    escenario.maxCosechaPorArea.resize(numeroCultivos);
+    escenario.cambioSalinidadPorArea.resize(numeroCultivos);
+    escenario.susceptibilidadAgua.resize(numeroCultivos);
+    for (int c = 0; c < numeroCultivos; ++c) {
+        int b = c % cultivosBase;
+        escenario.mesesCultivo[c] = base.mesesCultivo[b];
+        escenario.requerimientoAgua[c] = base.requerimientoAgua[b];
+        escenario.reduccionRendimiento[c] = base.reduccionRendimiento[b];
+        escenario.salinidadCritica[c] = base.salinidadCritica[b];
+        escenario.maxCosechaPorArea[c] = base.maxCosechaPorArea[b];
+        escenario.cambioSalinidadPorArea[c] = base.cambioSalinidadPorArea[b];
+        escenario.susceptibilidadAgua[c] = base.susceptibilidadAgua[b];
+    }
+    escenario.aguaInicialDisponible.resize(meses);
+    escenario.cultivable.resize(numeroCultivos * meses);
+    for (int mes = 0; mes < meses; ++mes) {
+        escenario.aguaInicialDisponible[mes] = base.aguaInicialDisponible[mes % mesesBase];
+        for (int c = 0; c < numeroCultivos; ++c) {
+            escenario.cultivable[c + numeroCultivos * mes] = base.cultivable[c % cultivosBase + cultivosBase * (mes % mesesBase)];
+        }
+    }
+    return escenario;
+}
+
+// Repetir operacion(i) en tandas crecientes hasta acumular tiempoMinimo segundos.
+// El tiempo se reparte entre los 'elementos' que procesa cada llamada
+template <class Operacion>
+static Medicion medir(const char* nombre, int cultivos, int meses, double tiempoMinimo, int elementos, Operacion operacion) {
+    long iteraciones = 0;
+    long tanda = 16;
+    double segundos = 0.0;
+    while (segundos < tiempoMinimo) {
+        Reloj::time_point inicio = Reloj::now();
+        for (long i = 0; i < tanda; ++i) operacion(iteraciones + i);
+        segundos += segundosDesde(inicio);
+        iteraciones += tanda;
+        tanda *= 2;
+    }
+    Medicion medicion = {nombre, cultivos, meses, iteraciones * elementos, 1e9 * segundos / (iteraciones * elementos)};
+    cerr << "  " << nombre << " " << cultivos << "x" << meses << ": " << medicion.nsPorOperacion << " ns" << endl;
+    return medicion;
+}
+
+// Como medir, pero 'preparar' corre antes de cada llamada fuera del tiempo medido
+template <class Preparacion, class Operacion>
+static Medicion medirConPreparacion(const char* nombre, int cultivos, int meses, double tiempoMinimo,
+                                    Preparacion preparar, Operacion operacion) {
+    long iteraciones = 0;
+    double segundos = 0.0;
+    while (segundos < tiempoMinimo) {
+        preparar(iteraciones);
+        Reloj::time_point inicio = Reloj::now();
+        operacion(iteraciones);
+        segundos += segundosDesde(inicio);
+        ++iteraciones;
+    }
+    Medicion medicion = {nombre, cultivos, meses, iteraciones, 1e9 * segundos / iteraciones};
+    cerr << "  " << nombre << " " << cultivos << "x" << meses << ": " << medicion.nsPorOperacion << " ns" << endl;
+    return medicion;
+}
+
+// Microbenchmarks de un solo hilo sobre una poblacion de muestra del escenario
+static void medirOperadores(int numeroCultivos, int meses, uint64_t semilla, double tiempoMinimo, vector<Medicion>& mediciones) {
+    const int MUESTRA = 256;
+    int dimension = numeroCultivos * meses;
+    Cultivacion cultivacion = crearEscenario(numeroCultivos, meses);
+
+    Generacion generacion(0, dimension);
+    generacion.tamanoPoblacion = MUESTRA;
+    generacion.semilla = semilla;
+    generacion.inicializarCromosomas(numeroCultivos, meses, cultivacion);
+    generacion.inicializarValoresObjetivo(numeroCultivos, meses, cultivacion);
+    const Poblacion& muestra = generacion.poblacion;
+
+    // Hijos cruzados sin validar y ya validados, para alimentar validarHijo y mutarCromosoma
+    GeneradorAleatorio gen(semilla, 1);
+    ArenaTrabajo arena;  // Se reinicia en cada llamada, como por hijo en obtenerNuevaGeneracion
+    Poblacion cruzados(MUESTRA, dimension);
+    Poblacion validados(MUESTRA, dimension);
+    vector<int> siembrasValidados(static_cast<size_t>(MUESTRA) * meses);  // Siembras por mes de cada hijo validado
+    for (int i = 0; i + 1 < MUESTRA; i += 2) {
+        generacion.realizarCruce(muestra[i], muestra[i + 1], numeroCultivos, meses, cruzados[i], cruzados[i + 1], gen);
+    }
+    for (int i = 0; i < MUESTRA; ++i) {
+        arena.reiniciar();
+        generacion.validarHijo(cruzados[i], numeroCultivos, meses, cultivacion, validados[i],
+                               Fila<int>(siembrasValidados.data() + static_cast<size_t>(i) * meses, meses), arena, gen);
+    }
+
+    Cromosoma trabajo1(dimension);
+    Cromosoma trabajo2(dimension);
+    double sumidero = 0.0;
+
+    mediciones.push_back(medir("Cromosoma::inicializar", numeroCultivos, meses, tiempoMinimo, 1, [&](long) {
+        arena.reiniciar();
+        Cromosoma::inicializar(trabajo1.vista(), numeroCultivos, meses, cultivacion.mesesCultivo, cultivacion.requerimientoAgua,
+                               cultivacion.prepararFactibilidad(numeroCultivos, meses), cultivacion.aguaInicialDisponible, cultivacion.areaTotalDisponible, arena, gen);
+    }));
+
+    mediciones.push_back(medir("realizarCruce", numeroCultivos, meses, tiempoMinimo, 1, [&](long i) {
+        int padre1 = static_cast<int>(i % MUESTRA);
+        int padre2 = static_cast<int>((i * 7 + 3) % MUESTRA);
+        generacion.realizarCruce(muestra[padre1], muestra[padre2], numeroCultivos, meses, trabajo1.vista(), trabajo2.vista(), gen);
+    }));
+
+    mediciones.push_back(medir("validarHijo", numeroCultivos, meses, tiempoMinimo, 1, [&](long i) {
+        arena.reiniciar();
+        Fila<int> siembrasPorMes = arena.reservar<int>(meses);
+        generacion.validarHijo(cruzados[static_cast<int>(i % MUESTRA)], numeroCultivos, meses, cultivacion, trabajo1.vista(),
+                               siembrasPorMes, arena, gen);
+    }));
+
+    // Cada mutacion parte de una copia del hijo validado y de sus siembras por mes; la copia entra en el tiempo medido
+    mediciones.push_back(medir("mutarCromosoma", numeroCultivos, meses, tiempoMinimo, 1, [&](long i) {
+        int k = static_cast<int>(i % MUESTRA);
+        trabajo1.vista().copiarDe(validados[k]);
+        arena.reiniciar();
+        Fila<int> siembrasPorMes = arena.reservar<int>(meses);
+        copy(siembrasValidados.begin() + static_cast<size_t>(k) * meses, siembrasValidados.begin() + static_cast<size_t>(k + 1) * meses,
+             siembrasPorMes.begin());
+        generacion.mutarCromosoma(trabajo1.vista(), numeroCultivos, meses, cultivacion, siembrasPorMes, arena, gen);
+    }));
+
+    mediciones.push_back(medir("funcionObjetivo", numeroCultivos, meses, tiempoMinimo, 1, [&](long i) {
+        arena.reiniciar();
+        sumidero += generacion.funcionObjetivo(muestra[static_cast<int>(i % MUESTRA)], numeroCultivos, meses, cultivacion, arena);
+    }));
+
+    // Nucleo por lotes sin cache ni reanudacion: tiempo por cromosoma
+    Poblacion copiaMuestra = muestra;
+    generacion.evaluador.preparar(cultivacion, numeroCultivos, meses, 1);
+    int lotes = generacion.evaluador.numeroLotes(copiaMuestra);
+    mediciones.push_back(medir("funcionObjetivo por lotes", numeroCultivos, meses, tiempoMinimo, CARRILES_LOTE, [&](long i) {
+        generacion.evaluador.evaluarLote(copiaMuestra, static_cast<int>(i % lotes), numeroCultivos, meses, 0);
+    }));
+
+    // Seleccion de sobrevivientes entre la poblacion de muestra y los hijos validados, con la cache vacia
+    Poblacion padres = muestra;
+    generacion.padresHijos.resize(MUESTRA);
+    for (int i = 0; i < MUESTRA; ++i) generacion.padresHijos[i] = make_pair(i & ~1, i | 1);
+    mediciones.push_back(medirConPreparacion("combinarGeneraciones", numeroCultivos, meses, tiempoMinimo, [&](long) {
+        generacion.poblacion = padres;
+        generacion.cacheAptitud.limpiar();
+    }, [&](long) {
+        generacion.combinarGeneraciones(validados, numeroCultivos, meses, cultivacion);
+    }));
+
+    if (sumidero == 0.12345) cerr << sumidero << endl;  // Evita que se descarten las evaluaciones escalares
+}
+
+// Inicializacion de la poblacion (un hilo) con el agua del escenario por defecto multiplicada por factorAgua.
+// El muestreo por rechazo tarda cada vez mas a medida que el agua escasea y, cuando ninguna siembra cabe en un
+// mes con el area libre, no termina; por eso solo se mide con poca restriccion
+static MedicionInicializacion medirInicializacion(TipoMuestreo muestreo, double factorAgua, uint64_t semilla, double tiempoMinimo) {
+    const int MUESTRA = 256;
+    const int CULTIVOS = 5, MESES = 8;
+    Cultivacion cultivacion = crearEscenario(CULTIVOS, MESES);
+    for (double& agua : cultivacion.aguaInicialDisponible) agua *= factorAgua;
+
+    Generacion generacion(0, CULTIVOS * MESES);
+    generacion.tamanoPoblacion = MUESTRA;
+    generacion.muestreo = muestreo;
+    long cromosomas = 0;
+    double segundos = 0.0;
+    while (segundos < tiempoMinimo) {
+        generacion.poblacion.limpiar();
+        generacion.semilla = semilla + cromosomas;  // Otros cromosomas en cada tanda
+        Reloj::time_point inicio = Reloj::now();
+        generacion.inicializarCromosomas(CULTIVOS, MESES, cultivacion);
+        segundos += segundosDesde(inicio);
+        cromosomas += MUESTRA;
+    }
+
+    const char* nombre = muestreo == MUESTREO_CONSTRUCTIVO ? "constructivo" : "rechazo";
+    MedicionInicializacion medicion = {nombre, factorAgua, cromosomas, 1e9 * segundos / cromosomas};
+    cerr << "  " << nombre << ", agua x" << factorAgua << ": " << medicion.nsPorCromosoma << " ns por cromosoma" << endl;
+    return medicion;
+}
+
+// Generaciones por segundo de la corrida completa (cruce, validacion, mutacion, evaluacion y seleccion)
+static MedicionGeneraciones medirGeneraciones(int numeroCultivos, int meses, int tamanoPoblacion, uint64_t semilla,
+                                              double tiempoMinimo, PoolHilos& poolHilos) {
+    int dimension = numeroCultivos * meses;
+    Cultivacion cultivacion = crearEscenario(numeroCultivos, meses);
+
+    Generacion generacion(0, dimension);
+    generacion.tamanoPoblacion = tamanoPoblacion;
+    generacion.poolHilos = &poolHilos;
+    generacion.semilla = semilla;
+    generacion.inicializarCromosomas(numeroCultivos, meses, cultivacion);
+    generacion.inicializarValoresObjetivo(numeroCultivos, meses, cultivacion);
+
+    long generaciones = 0;
+    Reloj::time_point inicio = Reloj::now();
+    double segundos = 0.0;
+    while (generaciones < 2 || segundos < tiempoMinimo) {
+        generacion.obtenerNuevaGeneracion(tamanoPoblacion, numeroCultivos, meses, cultivacion);
+        ++generaciones;
+        segundos = segundosDesde(inicio);
+    }
+
+    MedicionGeneraciones medicion = {numeroCultivos, meses, tamanoPoblacion, generaciones, segundos, generaciones / segundos,
+                                     generacion.encontrarMejorCromosoma().valorObjetivo};
+    cerr << "  poblacion " << tamanoPoblacion << " " << numeroCultivos << "x" << meses << ": "
+         << medicion.generacionesPorSegundo << " generaciones/s" << endl;
+    return medicion;
+}
+
+// Generaciones por segundo y memoria por individuo de la misma corrida con cada representacion. La densa
+// evalua con el nucleo por lotes y la cache; la dispersa evalua cada hijo al producirlo
+static MedicionRepresentacion medirRepresentacion(TipoRepresentacion representacion, int numeroCultivos, int meses, int tamanoPoblacion,
+                                                  uint64_t semilla, double tiempoMinimo, PoolHilos& poolHilos) {
+    Cultivacion cultivacion = crearEscenario(numeroCultivos, meses);
+    long generaciones = 0;
+    double segundos = 0.0, bytes = 0.0, mejor = 0.0;
+    if (representacion == REPRESENTACION_DENSA) {
+        Generacion generacion(0, numeroCultivos * meses);
+        generacion.tamanoPoblacion = tamanoPoblacion;
+        generacion.poolHilos = &poolHilos;
+        generacion.semilla = semilla;
+        generacion.inicializarCromosomas(numeroCultivos, meses, cultivacion);
+        generacion.inicializarValoresObjetivo(numeroCultivos, meses, cultivacion);
+        Reloj::time_point inicio = Reloj::now();
+        while (generaciones < 2 || segundos < tiempoMinimo) {
+            generacion.obtenerNuevaGeneracion(tamanoPoblacion, numeroCultivos, meses, cultivacion);
+            ++generaciones;
+            segundos = segundosDesde(inicio);
+        }
+        bytes = 2.0 * numeroCultivos * meses * sizeof(TipoGen);
+        mejor = generacion.encontrarMejorCromosoma().valorObjetivo;
+    } else {
+        GeneracionDispersa generacion;
+        generacion.tamanoPoblacion = tamanoPoblacion;
+        generacion.poolHilos = &poolHilos;
+        generacion.semilla = semilla;
+        generacion.inicializarPlanes(numeroCultivos, meses, cultivacion);
+        generacion.inicializarValoresObjetivo(numeroCultivos, meses, cultivacion);
+        Reloj::time_point inicio = Reloj::now();
+        while (generaciones < 2 || segundos < tiempoMinimo) {
+            generacion.obtenerNuevaGeneracion(tamanoPoblacion, numeroCultivos, meses, cultivacion);
+            ++generaciones;
+            segundos = segundosDesde(inicio);
+        }
+        for (const PlanSiembra& plan : generacion.poblacion) bytes += plan.bytes();
+        bytes /= generacion.poblacion.size();
+        mejor = generacion.valoresObjetivo[0];
+    }
+
+    const char* nombre = representacion == REPRESENTACION_DISPERSA ? "dispersa" : "densa";
+    MedicionRepresentacion medicion = {nombre, numeroCultivos, meses, tamanoPoblacion, generaciones, generaciones / segundos, bytes, mejor};
+    cerr << "  " << nombre << " " << numeroCultivos << "x" << meses << ": " << medicion.generacionesPorSegundo << " generaciones/s, "
+         << medicion.bytesPorIndividuo << " bytes por individuo" << endl;
+    return medicion;
+}
+
+static void escribirJson(ostream& salida, uint64_t semilla, int numeroHilos, const vector<Medicion>& mediciones,
+                         const vector<MedicionInicializacion>& inicializaciones, const vector<MedicionGeneraciones>& generaciones,
+                         const vector<MedicionRepresentacion>& representaciones) {
+    salida << setprecision(6);
+    salida << "{\n";
+    salida << "  \"formato\": 1,\n";
+    salida << "  \"compilador\": \"" << __VERSION__ << "\",\n";
+    salida << "  \"semilla\": " << semilla << ",\n";
+    salida << "  \"hilos\": " << numeroHilos << ",\n";
+    salida << "  \"operadores\": [\n";
+    for (size_t i = 0; i < mediciones.size(); ++i) {
+        const Medicion& m = mediciones[i];
+        salida << "    {\"nombre\": \"" << m.nombre << "\", \"cultivos\": " << m.cultivos << ", \"meses\": " << m.meses
+               << ", \"iteraciones\": " << m.iteraciones << ", \"ns_por_operacion\": " << m.nsPorOperacion << "}"
+               << (i + 1 < mediciones.size() ? "," : "") << "\n";
+    }
+    salida << "  ],\n";
+    salida << "  \"inicializacion\": [\n";
+    for (size_t i = 0; i < inicializaciones.size(); ++i) {
+        const MedicionInicializacion& m = inicializaciones[i];
+        salida << "    {\"muestreo\": \"" << m.muestreo << "\", \"factor_agua\": " << m.factorAgua << ", \"cromosomas\": " << m.cromosomas
+               << ", \"ns_por_cromosoma\": " << m.nsPorCromosoma << "}" << (i + 1 < inicializaciones.size() ? "," : "") << "\n";
+    }
+    salida << "  ],\n";
+    salida << "  \"generaciones\": [\n";
+    for (size_t i = 0; i < generaciones.size(); ++i) {
+        const MedicionGeneraciones& g = generaciones[i];
+        salida << "    {\"cultivos\": " << g.cultivos << ", \"meses\": " << g.meses << ", \"poblacion\": " << g.tamanoPoblacion
+               << ", \"generaciones\": " << g.generaciones << ", \"segundos\": " << g.segundos
+               << ", \"generaciones_por_segundo\": " << g.generacionesPorSegundo
+               << ", \"mejor_valor_objetivo\": " << g.mejorValorObjetivo << "}"
+               << (i + 1 < generaciones.size() ? "," : "") << "\n";
+    }
+    salida << "  ],\n";
+    salida << "  \"representacion\": [\n";
+    for (size_t i = 0; i < representaciones.size(); ++i) {
+        const MedicionRepresentacion& r = representaciones[i];
+        salida << "    {\"representacion\": \"" << r.representacion << "\", \"cultivos\": " << r.cultivos << ", \"meses\": " << r.meses
+               << ", \"poblacion\": " << r.tamanoPoblacion << ", \"generaciones\": " << r.generaciones
+               << ", \"generaciones_por_segundo\": " << r.generacionesPorSegundo << ", \"bytes_por_individuo\": " << r.bytesPorIndividuo
+               << ", \"mejor_valor_objetivo\": " << r.mejorValorObjetivo << "}" << (i + 1 < representaciones.size() ? "," : "") << "\n";
+    }
+    salida << "  ]\n";
+    salida << "}\n";
+}
+
+int main(int argc, char* argv[]) {
+    int numeroHilos = 0;          // Hilos para la medicion de punta a punta (0 = todos los nucleos)
+    uint64_t semilla = 1;         // Semilla fija para que las corridas sean comparables
+    double tiempoMinimo = 0.5;    // Segundos minimos por medicion
+    int poblacionMaxima = 100000; // Tamano de poblacion mas grande a medir
+    const char* archivoSalida = nullptr;
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            numeroHilos = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            semilla = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--tiempo") == 0 && i + 1 < argc) {
+            tiempoMinimo = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--maximo") == 0 && i + 1 < argc) {
+            poblacionMaxima = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--rapido") == 0) {
+            tiempoMinimo = 0.05;
+            poblacionMaxima = 1000;
+        } else if (strcmp(argv[i], "--salida") == 0 && i + 1 < argc) {
+            archivoSalida = argv[++i];
+        } else {
+            cerr << "Uso: " << argv[0] << " [--threads N] [--seed S] [--tiempo SEG] [--maximo N] [--rapido] [--salida ARCHIVO]" << endl;
+            return 1;
+        }
+    }
+
+    const int PROBLEMAS[][2] = {{5, 8}, {12, 24}};  // Cultivos x meses
+    const int POBLACIONES[] = {100, 1000, 10000, 100000};
+    const double FACTORES_AGUA[] = {1.0, 0.9, 0.8, 0.6, 0.4, 0.2, 0.1, 0.0};
+    const double FACTOR_MINIMO_RECHAZO = 0.8;  // Por debajo, el muestreo por rechazo puede no terminar
+    const int PROBLEMAS_GRANDES[][2] = {{12, 24}, {200, 120}};  // Cultivos x meses para comparar representaciones
+    const int POBLACION_REPRESENTACION = 100;
+
+    PoolHilos poolHilos(numeroHilos);
+    vector<Medicion> mediciones;
+    vector<MedicionInicializacion> inicializaciones;
+    vector<MedicionGeneraciones> generaciones;
+    vector<MedicionRepresentacion> representaciones;
+
+    cerr << "Operadores (un hilo)" << endl;
+    for (const int* problema : PROBLEMAS) {
+        medirOperadores(problema[0], problema[1], semilla, tiempoMinimo, mediciones);
+    }
+
+    cerr << "Inicializacion con agua escasa (5x8, un hilo)" << endl;
+    for (double factorAgua : FACTORES_AGUA) {
+        if (factorAgua >= FACTOR_MINIMO_RECHAZO) {
+            inicializaciones.push_back(medirInicializacion(MUESTREO_RECHAZO, factorAgua, semilla, tiempoMinimo));
+        }
+        inicializaciones.push_back(medirInicializacion(MUESTREO_CONSTRUCTIVO, factorAgua, semilla, tiempoMinimo));
+    }
+
+    cerr << "Generaciones (" << poolHilos.numeroHilos() << " hilos)" << endl;
+    for (const int* problema : PROBLEMAS) {
+        for (int tamanoPoblacion : POBLACIONES) {
+            if (tamanoPoblacion > poblacionMaxima) continue;
+            generaciones.push_back(medirGeneraciones(problema[0], problema[1], tamanoPoblacion, semilla, tiempoMinimo, poolHilos));
+        }
+    }
+
+    cerr << "Representacion densa y dispersa, poblacion " << POBLACION_REPRESENTACION << " (" << poolHilos.numeroHilos() << " hilos)" << endl;
+    for (const int* problema : PROBLEMAS_GRANDES) {
+        for (TipoRepresentacion representacion : {REPRESENTACION_DENSA, REPRESENTACION_DISPERSA}) {
+            representaciones.push_back(medirRepresentacion(representacion, problema[0], problema[1], POBLACION_REPRESENTACION, semilla,
+                                                           tiempoMinimo, poolHilos));
+        }
+    }
+
+    if (archivoSalida != nullptr) {
+        ofstream archivo(archivoSalida);
+        escribirJson(archivo, semilla, poolHilos.numeroHilos(), mediciones, inicializaciones, generaciones, representaciones);
+    } else {
+        escribirJson(cout, semilla, poolHilos.numeroHilos(), mediciones, inicializaciones, generaciones, representaciones);
+    }
+    return 0;
+}
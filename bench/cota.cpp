@@ -0,0 +1,132 @@
+/*
+ * Comprobacion de la poda por cota superior (Generacion::podarPorCota).
+ * Un hijo se descarta sin evaluarlo solo si su cota superior no alcanza a los que sobreviven, asi que la poda no
+ * debe cambiar nada de la corrida. Para varios problemas y semillas se corren dos poblaciones en paralelo, una
+ * con la poda y otra sin ella, y despues de cada generacion se exige que tengan exactamente los mismos
+ * cromosomas, en el mismo orden y con los mismos valores objetivo. Termina con error a la primera diferencia.
+ *
+ * Uso: cota [--threads N] [--semillas N] [--generaciones N]
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+#include "Generacion.h"
+#include "PoolHilos.h"
+
+// Mismo escenario que bench/benchmark.cpp: repite los valores por defecto de Cultivacion (5 cultivos, 8 meses)
+static Cultivacion crearEscenario(int numeroCultivos, int meses) {
+    Cultivacion base;
+    Cultivacion escenario;
+    int cultivosBase = static_cast<int>(base.mesesCultivo.size());
+    int mesesBase = static_cast<int>(base.aguaInicialDisponible.size());
+    escenario.mesesCultivo.resize(numeroCultivos);
+    escenario.requerimientoAgua.resize(numeroCultivos);
+    escenario.reduccionRendimiento.resize(numeroCultivos);
+    escenario.salinidadCritica.resize(numeroCultivos);
+    escenario.maxCosechaPorArea.resize(numeroCultivos);
+    escenario.cambioSalinidadPorArea.resize(numeroCultivos);
+    escenario.susceptibilidadAgua.resize(numeroCultivos);
+    for (int c = 0; c < numeroCultivos; ++c) {
+        int b = c % cultivosBase;
+        escenario.mesesCultivo[c] = base.mesesCultivo[b];
+        escenario.requerimientoAgua[c] = base.requerimientoAgua[b];
+        escenario.reduccionRendimiento[c] = base.reduccionRendimiento[b];
+        escenario.salinidadCritica[c] = base.salinidadCritica[b];
+        escenario.maxCosechaPorArea[c] = base.maxCosechaPorArea[b];
+        escenario.cambioSalinidadPorArea[c] = base.cambioSalinidadPorArea[b];
+        escenario.susceptibilidadAgua[c] = base.susceptibilidadAgua[b];
+    }
+    escenario.aguaInicialDisponible.resize(meses);
+    escenario.cultivable.resize(numeroCultivos * meses);
+    for (int mes = 0; mes < meses; ++mes) {
+        escenario.aguaInicialDisponible[mes] = base.aguaInicialDisponible[mes % mesesBase];
+        for (int c = 0; c < numeroCultivos; ++c) {
+            escenario.cultivable[c + numeroCultivos * mes] = base.cultivable[c % cultivosBase + cultivosBase * (mes % mesesBase)];
+        }
+    }
+    return escenario;
+}
+
+static bool mismasPoblaciones(const Poblacion& a, const Poblacion& b) {
+    if (a.size() != b.size()) return false;
+    for (int i = 0; i < a.size(); ++i) {
+        if (a.valoresObjetivo[i] != b.valoresObjetivo[i]) return false;
+        VistaConstCromosoma filaA = a[i], filaB = b[i];
+        if (!equal(filaA.genes.begin(), filaA.genes.end(), filaB.genes.begin())) return false;
+    }
+    return true;
+}
+
+// Generacion en la que las dos corridas se separan, o -1 si coinciden hasta el final
+static int compararCorridas(int numeroCultivos, int meses, int tamanoPoblacion, int numeroGeneraciones, uint64_t semilla,
+                            PoolHilos& poolHilos, uint64_t& descartados, uint64_t& acotados) {
+    Cultivacion cultivacion = crearEscenario(numeroCultivos, meses);
+    Generacion conCota(0, numeroCultivos * meses), sinCota(0, numeroCultivos * meses);
+    Generacion* corridas[] = {&conCota, &sinCota};
+    for (Generacion* g : corridas) {
+        g->tamanoPoblacion = tamanoPoblacion;
+        g->poolHilos = &poolHilos;
+        g->semilla = semilla;
+        g->inicializarCromosomas(numeroCultivos, meses, cultivacion);
+        g->inicializarValoresObjetivo(numeroCultivos, meses, cultivacion);
+    }
+    sinCota.podarPorCota = false;
+
+    for (int generacion = 1; generacion <= numeroGeneraciones; ++generacion) {
+        for (Generacion* g : corridas) g->obtenerNuevaGeneracion(tamanoPoblacion, numeroCultivos, meses, cultivacion);
+        if (!mismasPoblaciones(conCota.poblacion, sinCota.poblacion)) return generacion;
+    }
+    descartados += conCota.hijosDescartados;
+    acotados += conCota.hijosAcotados;
+    return -1;
+}
+
+int main(int argc, char* argv[]) {
+    int numeroHilos = 0;           // 0 = todos los nucleos
+    int numeroSemillas = 4;        // Corridas por problema
+    int numeroGeneraciones = 100;  // Generaciones de cada corrida
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            numeroHilos = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--semillas") == 0 && i + 1 < argc) {
+            numeroSemillas = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--generaciones") == 0 && i + 1 < argc) {
+            numeroGeneraciones = atoi(argv[++i]);
+        } else {
+            cerr << "Uso: " << argv[0] << " [--threads N] [--semillas N] [--generaciones N]" << endl;
+            return 1;
+        }
+    }
+
+    const int PROBLEMAS[][2] = {{5, 8}, {12, 24}, {40, 60}};  // Cultivos x meses
+    const int TAMANO_POBLACION = 200;
+
+    PoolHilos poolHilos(numeroHilos);
+    bool correcto = true;
+    cout << "Poda por cota frente a evaluar todos los hijos, poblacion " << TAMANO_POBLACION << ", " << numeroGeneraciones
+         << " generaciones" << endl;
+    for (const int* problema : PROBLEMAS) {
+        uint64_t descartados = 0, acotados = 0;
+        bool iguales = true;
+        cout << "  " << problema[0] << "x" << problema[1] << ":";
+        for (int s = 1; s <= numeroSemillas; ++s) {
+            int diferencia = compararCorridas(problema[0], problema[1], TAMANO_POBLACION, numeroGeneraciones, s, poolHilos,
+                                              descartados, acotados);
+            if (diferencia >= 0) {
+                cout << " semilla " << s << " DIFIERE en la generacion " << diferencia;
+                iguales = false;
+            }
+        }
+        cout << " " << descartados << " de " << acotados << " hijos descartados sin evaluar, poblaciones "
+             << (iguales ? "identicas" : "distintas") << endl;
+        correcto = correcto && iguales;
+    }
+    return correcto ? 0 : 1;
+}
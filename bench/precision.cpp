@@ -0,0 +1,194 @@
+/*
+ * Validacion del almacenamiento de genes en precision simple (-DGA_PRECISION_SIMPLE).
+ * Corre el algoritmo genetico un numero fijo de generaciones sobre varios problemas y semillas y anota la mejor
+ * cosecha de cada corrida. Compilado con TipoGen = double guarda esas cosechas como referencia (--salida);
+ * compilado con TipoGen = float las compara con la referencia (--referencia) y termina con error si la cosecha
+ * media de algun problema se aleja mas que la tolerancia relativa. Las corridas individuales pueden separarse
+ * porque un redondeo distinto cambia el camino de la busqueda; lo que se exige es que la calidad no cambie.
+ *
+ * Uso: precision [--threads N] [--semillas N] [--generaciones N] [--tolerancia T] [--rapido]
+ *                [--salida ARCHIVO] [--referencia ARCHIVO]
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+#include "Generacion.h"
+#include "PoolHilos.h"
+
+typedef chrono::steady_clock Reloj;
+
+struct CorridaPrecision {
+    int cultivos;
+    int meses;
+    uint64_t semilla;
+    double cosecha;   // Mejor valor objetivo al terminar
+    double segundos;
+};
+
+// Mismo escenario que bench/benchmark.cpp: repite los valores por defecto de Cultivacion (5 cultivos, 8 meses)
+static Cultivacion crearEscenario(int numeroCultivos, int meses) {
+    Cultivacion base;
+    Cultivacion escenario;
+    int cultivosBase = static_cast<int>(base.mesesCultivo.size());
+    int mesesBase = static_cast<int>(base.aguaInicialDisponible.size());
+    escenario.mesesCultivo.resize(numeroCultivos);
+    escenario.requerimientoAgua.resize(numeroCultivos);
+    escenario.reduccionRendimiento.resize(numeroCultivos);
+    escenario.salinidadCritica.resize(numeroCultivos);
+    escenario.maxCosechaPorArea.resize(numeroCultivos);
+    escenario.cambioSalinidadPorArea.resize(numeroCultivos);
+    escenario.susceptibilidadAgua.resize(numeroCultivos);
+    for (int c = 0; c < numeroCultivos; ++c) {
+        int b = c % cultivosBase;
+        escenario.mesesCultivo[c] = base.mesesCultivo[b];
+        escenario.requerimientoAgua[c] = base.requerimientoAgua[b];
+        escenario.reduccionRendimiento[c] = base.reduccionRendimiento[b];
+        escenario.salinidadCritica[c] = base.salinidadCritica[b];
+        escenario.maxCosechaPorArea[c] = base.maxCosechaPorArea[b];
+        escenario.cambioSalinidadPorArea[c] = base.cambioSalinidadPorArea[b];
+        escenario.susceptibilidadAgua[c] = base.susceptibilidadAgua[b];
+    }
+    escenario.aguaInicialDisponible.resize(meses);
+    escenario.cultivable.resize(numeroCultivos * meses);
+    for (int mes = 0; mes < meses; ++mes) {
+        escenario.aguaInicialDisponible[mes] = base.aguaInicialDisponible[mes % mesesBase];
+        for (int c = 0; c < numeroCultivos; ++c) {
+            escenario.cultivable[c + numeroCultivos * mes] = base.cultivable[c % cultivosBase + cultivosBase * (mes % mesesBase)];
+        }
+    }
+    return escenario;
+}
+
+static CorridaPrecision correr(int numeroCultivos, int meses, int tamanoPoblacion, int numeroGeneraciones, uint64_t semilla,
+                               PoolHilos& poolHilos) {
+    Cultivacion cultivacion = crearEscenario(numeroCultivos, meses);
+    Generacion generacion(0, numeroCultivos * meses);
+    generacion.tamanoPoblacion = tamanoPoblacion;
+    generacion.poolHilos = &poolHilos;
+    generacion.semilla = semilla;
+
+    Reloj::time_point inicio = Reloj::now();
+    generacion.inicializarCromosomas(numeroCultivos, meses, cultivacion);
+    generacion.inicializarValoresObjetivo(numeroCultivos, meses, cultivacion);
+    for (int i = 0; i < numeroGeneraciones; ++i) generacion.obtenerNuevaGeneracion(tamanoPoblacion, numeroCultivos, meses, cultivacion);
+    CorridaPrecision corrida = {numeroCultivos, meses, semilla, generacion.encontrarMejorCromosoma().valorObjetivo,
+                                chrono::duration<double>(Reloj::now() - inicio).count()};
+    return corrida;
+}
+
+// Referencia escrita por la version en double: una corrida por linea, "cultivos meses semilla cosecha segundos"
+static bool leerReferencia(const char* ruta, vector<CorridaPrecision>& corridas) {
+    ifstream archivo(ruta);
+    if (!archivo) return false;
+    CorridaPrecision c;
+    while (archivo >> c.cultivos >> c.meses >> c.semilla >> c.cosecha >> c.segundos) corridas.push_back(c);
+    return !corridas.empty();
+}
+
+static const CorridaPrecision* buscar(const vector<CorridaPrecision>& corridas, const CorridaPrecision& corrida) {
+    for (const CorridaPrecision& c : corridas) {
+        if (c.cultivos == corrida.cultivos && c.meses == corrida.meses && c.semilla == corrida.semilla) return &c;
+    }
+    return nullptr;
+}
+
+int main(int argc, char* argv[]) {
+    int numeroHilos = 0;           // 0 = todos los nucleos; el resultado no depende del numero de hilos
+    int numeroSemillas = 8;        // Corridas por problema
+    int numeroGeneraciones = 200;  // Generaciones de cada corrida
+    double tolerancia = 0.01;      // Diferencia relativa admitida en la cosecha media de cada problema
+    const char* archivoSalida = nullptr;
+    const char* archivoReferencia = nullptr;
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            numeroHilos = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--semillas") == 0 && i + 1 < argc) {
+            numeroSemillas = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--generaciones") == 0 && i + 1 < argc) {
+            numeroGeneraciones = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--tolerancia") == 0 && i + 1 < argc) {
+            tolerancia = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--rapido") == 0) {
+            numeroSemillas = 3;
+            numeroGeneraciones = 50;
+        } else if (strcmp(argv[i], "--salida") == 0 && i + 1 < argc) {
+            archivoSalida = argv[++i];
+        } else if (strcmp(argv[i], "--referencia") == 0 && i + 1 < argc) {
+            archivoReferencia = argv[++i];
+        } else {
+            cerr << "Uso: " << argv[0] << " [--threads N] [--semillas N] [--generaciones N] [--tolerancia T] [--rapido]"
+                 << " [--salida ARCHIVO] [--referencia ARCHIVO]" << endl;
+            return 1;
+        }
+    }
+
+    vector<CorridaPrecision> referencia;
+    if (archivoReferencia != nullptr && !leerReferencia(archivoReferencia, referencia)) {
+        cerr << "No se pudo leer la referencia " << archivoReferencia << endl;
+        return 1;
+    }
+
+    const int PROBLEMAS[][2] = {{5, 8}, {12, 24}, {40, 60}};  // Cultivos x meses
+    const int TAMANO_POBLACION = 200;
+
+    PoolHilos poolHilos(numeroHilos);
+    vector<CorridaPrecision> corridas;
+    bool correcto = true;
+    cout << setprecision(6);
+    cout << "Genes en " << (sizeof(TipoGen) == sizeof(float) ? "float" : "double") << ", " << 2 * sizeof(TipoGen)
+         << " bytes por cultivo y mes (genes y cultivoPlantado), poblacion " << TAMANO_POBLACION << ", " << numeroGeneraciones
+         << " generaciones" << endl;
+    for (const int* problema : PROBLEMAS) {
+        double cosecha = 0.0, cosechaReferencia = 0.0, segundos = 0.0, segundosReferencia = 0.0, diferenciaMaxima = 0.0;
+        int comparadas = 0;
+        for (int s = 1; s <= numeroSemillas; ++s) {
+            CorridaPrecision corrida = correr(problema[0], problema[1], TAMANO_POBLACION, numeroGeneraciones, s, poolHilos);
+            corridas.push_back(corrida);
+            cosecha += corrida.cosecha;
+            segundos += corrida.segundos;
+            const CorridaPrecision* igual = buscar(referencia, corrida);
+            if (igual == nullptr) continue;
+            cosechaReferencia += igual->cosecha;
+            segundosReferencia += igual->segundos;
+            diferenciaMaxima = max(diferenciaMaxima, fabs(corrida.cosecha - igual->cosecha) / max(fabs(igual->cosecha), 1e-12));
+            ++comparadas;
+        }
+
+        cout << "  " << problema[0] << "x" << problema[1] << ": cosecha media " << cosecha / numeroSemillas << ", "
+             << segundos / numeroSemillas << " s por corrida";
+        if (archivoReferencia != nullptr) {
+            if (comparadas != numeroSemillas) {
+                cout << endl << "    la referencia no tiene todas las corridas de este problema" << endl;
+                correcto = false;
+                continue;
+            }
+            double diferencia = fabs(cosecha - cosechaReferencia) / max(fabs(cosechaReferencia), 1e-12);
+            bool dentro = diferencia <= tolerancia;
+            correcto = correcto && dentro;
+            cout << "; referencia " << cosechaReferencia / numeroSemillas << ", " << segundosReferencia / numeroSemillas
+                 << " s; diferencia de la media " << diferencia << " (maxima por corrida " << diferenciaMaxima << ") "
+                 << (dentro ? "dentro" : "FUERA") << " de la tolerancia " << tolerancia;
+        }
+        cout << endl;
+    }
+
+    if (archivoSalida != nullptr) {
+        ofstream archivo(archivoSalida);
+        archivo << setprecision(17);
+        for (const CorridaPrecision& c : corridas) {
+            archivo << c.cultivos << " " << c.meses << " " << c.semilla << " " << c.cosecha << " " << c.segundos << "\n";
+        }
+    }
+    return correcto ? 0 : 1;
+}
@@ -0,0 +1,196 @@
+/*
+ * Comprobacion de que una corrida reanudada desde un punto de control trabaja igual que la corrida sin interrumpir.
+ * El punto de control no guarda los estados por mes de la evaluacion incremental; al reanudar se reconstruyen
+ * reevaluando la poblacion. Para varios problemas y semillas se corre sin interrupcion, guardando el punto de
+ * control a mitad de camino, y despues se reanuda desde el y se exige lo mismo en la segunda mitad: la misma
+ * poblacion final y los mismos contadores de meses evaluados y reutilizados y de hijos descartados por la cota.
+ * La reevaluacion tampoco debe cambiar ningun valor objetivo. La cache de aptitud se desactiva en ambas corridas:
+ * la corrida reanudada empieza con ella vacia y sus aciertos cambiarian los contadores.
+ *
+ * Uso: reanudar [--threads N] [--semillas N] [--generaciones N] [--archivo RUTA]
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+#include "Generacion.h"
+#include "PoolHilos.h"
+#include "PuntoControl.h"
+
+// Mismo escenario que bench/benchmark.cpp: repite los valores por defecto de Cultivacion (5 cultivos, 8 meses)
+static Cultivacion crearEscenario(int numeroCultivos, int meses) {
+    Cultivacion base;
+    Cultivacion escenario;
+    int cultivosBase = static_cast<int>(base.mesesCultivo.size());
+    int mesesBase = static_cast<int>(base.aguaInicialDisponible.size());
+    escenario.mesesCultivo.resize(numeroCultivos);
+    escenario.requerimientoAgua.resize(numeroCultivos);
+    escenario.reduccionRendimiento.resize(numeroCultivos);
+    escenario.salinidadCritica.resize(numeroCultivos);
+    escenario.maxCosechaPorArea.resize(numeroCultivos);
+    escenario.cambioSalinidadPorArea.resize(numeroCultivos);
+    escenario.susceptibilidadAgua.resize(numeroCultivos);
+    for (int c = 0; c < numeroCultivos; ++c) {
+        int b = c % cultivosBase;
+        escenario.mesesCultivo[c] = base.mesesCultivo[b];
+        escenario.requerimientoAgua[c] = base.requerimientoAgua[b];
+        escenario.reduccionRendimiento[c] = base.reduccionRendimiento[b];
+        escenario.salinidadCritica[c] = base.salinidadCritica[b];
+        escenario.maxCosechaPorArea[c] = base.maxCosechaPorArea[b];
+        escenario.cambioSalinidadPorArea[c] = base.cambioSalinidadPorArea[b];
+        escenario.susceptibilidadAgua[c] = base.susceptibilidadAgua[b];
+    }
+    escenario.aguaInicialDisponible.resize(meses);
+    escenario.cultivable.resize(numeroCultivos * meses);
+    for (int mes = 0; mes < meses; ++mes) {
+        escenario.aguaInicialDisponible[mes] = base.aguaInicialDisponible[mes % mesesBase];
+        for (int c = 0; c < numeroCultivos; ++c) {
+            escenario.cultivable[c + numeroCultivos * mes] = base.cultivable[c % cultivosBase + cultivosBase * (mes % mesesBase)];
+        }
+    }
+    return escenario;
+}
+
+// Trabajo de la evaluacion acumulado por una corrida
+struct Contadores {
+    uint64_t mesesEvaluados;
+    uint64_t mesesOmitidos;
+    uint64_t hijosAcotados;
+    uint64_t hijosDescartados;
+
+    static Contadores de(const Generacion& g) {
+        Contadores c = {g.mesesEvaluados, g.mesesOmitidos, g.hijosAcotados, g.hijosDescartados};
+        return c;
+    }
+
+    Contadores desde(const Contadores& inicio) const {
+        Contadores c = {mesesEvaluados - inicio.mesesEvaluados, mesesOmitidos - inicio.mesesOmitidos,
+                        hijosAcotados - inicio.hijosAcotados, hijosDescartados - inicio.hijosDescartados};
+        return c;
+    }
+
+    bool operator==(const Contadores& otro) const {
+        return mesesEvaluados == otro.mesesEvaluados && mesesOmitidos == otro.mesesOmitidos &&
+               hijosAcotados == otro.hijosAcotados && hijosDescartados == otro.hijosDescartados;
+    }
+};
+
+static bool mismasPoblaciones(const Poblacion& a, const Poblacion& b) {
+    if (a.size() != b.size()) return false;
+    for (int i = 0; i < a.size(); ++i) {
+        if (a.valoresObjetivo[i] != b.valoresObjetivo[i]) return false;
+        VistaConstCromosoma filaA = a[i], filaB = b[i];
+        if (!equal(filaA.genes.begin(), filaA.genes.end(), filaB.genes.begin())) return false;
+    }
+    return true;
+}
+
+// Corre 'numeroGeneraciones' generaciones sin interrumpir y reanudando desde la mitad. Devuelve un mensaje con la
+// primera diferencia, o una cadena vacia si ambas corridas coinciden; en 'segundaMitad' deja sus contadores
+static string compararCorridas(int numeroCultivos, int meses, int tamanoPoblacion, int numeroGeneraciones, uint64_t semilla,
+                               PoolHilos& poolHilos, const string& archivo, Contadores& segundaMitad) {
+    Cultivacion cultivacion = crearEscenario(numeroCultivos, meses);
+    int mitad = numeroGeneraciones / 2;
+
+    Generacion continua(0, numeroCultivos * meses);
+    continua.tamanoPoblacion = tamanoPoblacion;
+    continua.poolHilos = &poolHilos;
+    continua.semilla = semilla;
+    continua.cacheAptitud.redimensionar(0);
+    continua.inicializarCromosomas(numeroCultivos, meses, cultivacion);
+    continua.inicializarValoresObjetivo(numeroCultivos, meses, cultivacion);
+    for (int i = 0; i < mitad; ++i) continua.obtenerNuevaGeneracion(tamanoPoblacion, numeroCultivos, meses, cultivacion);
+    {
+        PuntoControl puntoControl(archivo);
+        if (!puntoControl.guardar(continua, continua.encontrarMejorCromosoma(), numeroCultivos, meses) || !puntoControl.esperar()) {
+            return "no se pudo escribir " + archivo;
+        }
+    }
+    Contadores inicio = Contadores::de(continua);
+    for (int i = mitad; i < numeroGeneraciones; ++i) continua.obtenerNuevaGeneracion(tamanoPoblacion, numeroCultivos, meses, cultivacion);
+    segundaMitad = Contadores::de(continua).desde(inicio);
+
+    // Reanudar como main.cpp: cargar el punto de control y reevaluar para reconstruir los estados por mes
+    Generacion reanudada(0, numeroCultivos * meses);
+    reanudada.poolHilos = &poolHilos;
+    reanudada.cacheAptitud.redimensionar(0);
+    Cromosoma mejorCromosoma;
+    int cultivosGuardados = 0, mesesGuardados = 0;
+    string error;
+    if (!PuntoControl::cargar(archivo, reanudada, mejorCromosoma, cultivosGuardados, mesesGuardados, error)) return error;
+    remove(archivo.c_str());
+    vector<double> guardados = reanudada.poblacion.valoresObjetivo;
+    reanudada.inicializarValoresObjetivo(numeroCultivos, meses, cultivacion);
+    if (reanudada.poblacion.valoresObjetivo != guardados) return "la reevaluacion cambio valores objetivo";
+    inicio = Contadores::de(reanudada);
+    for (int i = mitad; i < numeroGeneraciones; ++i) reanudada.obtenerNuevaGeneracion(tamanoPoblacion, numeroCultivos, meses, cultivacion);
+
+    if (!mismasPoblaciones(continua.poblacion, reanudada.poblacion)) return "poblaciones finales distintas";
+    Contadores contadores = Contadores::de(reanudada).desde(inicio);
+    if (!(contadores == segundaMitad)) {
+        return "contadores distintos: reutilizados " + to_string(contadores.mesesOmitidos) + " frente a " +
+               to_string(segundaMitad.mesesOmitidos) + ", descartados " + to_string(contadores.hijosDescartados) +
+               " frente a " + to_string(segundaMitad.hijosDescartados);
+    }
+    return "";
+}
+
+int main(int argc, char* argv[]) {
+    int numeroHilos = 0;           // 0 = todos los nucleos
+    int numeroSemillas = 4;        // Corridas por problema
+    int numeroGeneraciones = 60;   // Generaciones de cada corrida; el punto de control se guarda en la mitad
+    string archivo = "reanudar.punto";
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            numeroHilos = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--semillas") == 0 && i + 1 < argc) {
+            numeroSemillas = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--generaciones") == 0 && i + 1 < argc) {
+            numeroGeneraciones = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--archivo") == 0 && i + 1 < argc) {
+            archivo = argv[++i];
+        } else {
+            cerr << "Uso: " << argv[0] << " [--threads N] [--semillas N] [--generaciones N] [--archivo RUTA]" << endl;
+            return 1;
+        }
+    }
+
+    const int PROBLEMAS[][2] = {{5, 8}, {12, 24}, {40, 60}};  // Cultivos x meses
+    const int TAMANO_POBLACION = 200;
+
+    PoolHilos poolHilos(numeroHilos);
+    bool correcto = true;
+    cout << "Corrida reanudada en la generacion " << numeroGeneraciones / 2 << " frente a la corrida sin interrumpir, poblacion "
+         << TAMANO_POBLACION << ", " << numeroGeneraciones << " generaciones" << endl;
+    for (const int* problema : PROBLEMAS) {
+        Contadores total = {0, 0, 0, 0};
+        bool iguales = true;
+        cout << "  " << problema[0] << "x" << problema[1] << ":";
+        for (int s = 1; s <= numeroSemillas; ++s) {
+            Contadores segundaMitad;
+            string diferencia = compararCorridas(problema[0], problema[1], TAMANO_POBLACION, numeroGeneraciones, s, poolHilos,
+                                                 archivo, segundaMitad);
+            if (!diferencia.empty()) {
+                cout << " semilla " << s << " DIFIERE (" << diferencia << ")";
+                iguales = false;
+            }
+            total.mesesEvaluados += segundaMitad.mesesEvaluados;
+            total.mesesOmitidos += segundaMitad.mesesOmitidos;
+            total.hijosAcotados += segundaMitad.hijosAcotados;
+            total.hijosDescartados += segundaMitad.hijosDescartados;
+        }
+        cout << " " << total.mesesOmitidos << " de " << total.mesesEvaluados + total.mesesOmitidos << " meses reutilizados, "
+             << total.hijosDescartados << " de " << total.hijosAcotados << " hijos descartados en la segunda mitad, corridas "
+             << (iguales ? "iguales" : "distintas") << endl;
+        correcto = correcto && iguales;
+    }
+    return correcto ? 0 : 1;
+}
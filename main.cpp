@@ -1,23 +1,219 @@
 #include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <cstdlib>
+#include <cstring>
 #include <ctime>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <limits>
+#include <memory>
 #include <numeric>
 #include <random>
 #include <vector>
 
 using namespace std;
 
+#include "ArchivoEscenarios.h"
+#include "Escenario.h"
 #include "Generacion.h"
+#include "Instrumentacion.h"
+#include "IslasDistribuidas.h"
+#include "LoteEscenarios.h"
+#include "ModeloIslas.h"
+#include "PuntoControl.h"
+#include "Terminacion.h"
 
-int main() {
-    srand(static_cast<unsigned int>(time(0)));
+GA_CONTAR_ASIGNACIONES()
 
+int main(int argc, char* argv[]) {
     // Parámetros del Algoritmo Genético
     int tamanoPoblacion = 100;  // Tamaño de la población
     int maximoGeneraciones = 100;  // Número máximo de generaciones
+    int numeroHilos = 0;  // Hilos de trabajo (0 = todos los núcleos disponibles)
+    uint64_t semilla = (static_cast<uint64_t>(random_device()()) << 32) ^ static_cast<uint64_t>(time(0));  // Semilla de la corrida
+    const char* archivoPerfil = nullptr;  // Reporte por generacion de la instrumentacion (.csv o .json)
+    const char* archivoTraza = nullptr;  // Traza de eventos para chrome://tracing
+    int numeroIslas = 1;  // Poblaciones independientes (1 = una sola poblacion con el pool de hilos)
+    int intervaloMigracion = 10;  // Generaciones entre migraciones del modelo de islas
+    int numeroMigrantes = 2;  // Cromosomas que cada isla envia a su vecina
+    int numeroProcesos = 1;  // Procesos trabajadores del modelo de islas distribuido (1 = un solo proceso)
+    const char* direccionCoordinador = nullptr;  // unix:/ruta o tcp:host:puerto donde escucha el coordinador
+    int identificadorTrabajador = -1;  // Solo en los procesos trabajadores lanzados por el coordinador
+    const char* archivoLote = nullptr;  // Lista de escenarios a resolver en un solo proceso
+    const char* archivoResultados = nullptr;  // CSV con un registro por escenario del lote (por omision, la salida estandar)
+    const char* archivoBinario = nullptr;  // Convertir la lista de escenarios de texto a su forma binaria y terminar
+    const char* archivoPuntoControl = nullptr;  // Donde guardar periodicamente el estado de la corrida
+    int generacionesPorPunto = 10;  // Generaciones entre puntos de control
+    CriterioTerminacion terminacion;  // Estancamiento, tiempo y valor meta para parar antes de maximoGeneraciones
+    const char* archivoEstadisticas = nullptr;  // CSV con el mejor, la media y el peor de cada generacion
+    OperadorSeleccion seleccion;  // Operador de seleccion de padres (uniforme, torneo, ranking o sus)
+    TipoMuestreo muestreo = MUESTREO_RECHAZO;  // Sorteo de siembras al inicializar y al ajustar areas
+    TipoRepresentacion representacion = REPRESENTACION_DENSA;  // Forma de los cromosomas en el modo lote
+    const char* archivoReanudar = nullptr;  // Punto de control desde el que continuar una corrida interrumpida
+    bool podarPorCota = true;  // Descartar sin evaluar los hijos cuya cota superior no alcanza a sobrevivir
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            numeroHilos = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--generaciones") == 0 && i + 1 < argc) {
+            maximoGeneraciones = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            semilla = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--perfil") == 0 && i + 1 < argc) {
+            archivoPerfil = argv[++i];
+        } else if (strcmp(argv[i], "--traza") == 0 && i + 1 < argc) {
+            archivoTraza = argv[++i];
+        } else if (strcmp(argv[i], "--islas") == 0 && i + 1 < argc) {
+            numeroIslas = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--intervalo") == 0 && i + 1 < argc) {
+            intervaloMigracion = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--migrantes") == 0 && i + 1 < argc) {
+            numeroMigrantes = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--procesos") == 0 && i + 1 < argc) {
+            numeroProcesos = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--direccion") == 0 && i + 1 < argc) {
+            direccionCoordinador = argv[++i];
+        } else if (strcmp(argv[i], "--trabajador") == 0 && i + 1 < argc) {
+            direccionCoordinador = argv[++i];
+        } else if (strcmp(argv[i], "--id") == 0 && i + 1 < argc) {
+            identificadorTrabajador = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--lote") == 0 && i + 1 < argc) {
+            archivoLote = argv[++i];
+        } else if (strcmp(argv[i], "--resultados") == 0 && i + 1 < argc) {
+            archivoResultados = argv[++i];
+        } else if (strcmp(argv[i], "--convertir") == 0 && i + 1 < argc) {
+            archivoBinario = argv[++i];
+        } else if (strcmp(argv[i], "--punto-control") == 0 && i + 1 < argc) {
+            archivoPuntoControl = argv[++i];
+        } else if (strcmp(argv[i], "--cada") == 0 && i + 1 < argc) {
+            generacionesPorPunto = max(1, atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--reanudar") == 0 && i + 1 < argc) {
+            archivoReanudar = argv[++i];
+        } else if (strcmp(argv[i], "--estancamiento") == 0 && i + 1 < argc) {
+            terminacion.generacionesSinMejora = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--tiempo") == 0 && i + 1 < argc) {
+            terminacion.segundosMaximos = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--meta") == 0 && i + 1 < argc) {
+            terminacion.valorMeta = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--estadisticas") == 0 && i + 1 < argc) {
+            archivoEstadisticas = argv[++i];
+        } else if (strcmp(argv[i], "--seleccion") == 0 && i + 1 < argc && interpretarSeleccion(argv[i + 1], seleccion.tipo)) {
+            ++i;
+        } else if (strcmp(argv[i], "--torneo") == 0 && i + 1 < argc) {
+            seleccion.tipo = SELECCION_TORNEO;
+            seleccion.tamanoTorneo = max(1, atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--representacion") == 0 && i + 1 < argc && interpretarRepresentacion(argv[i + 1], representacion)) {
+            ++i;
+        } else if (strcmp(argv[i], "--muestreo") == 0 && i + 1 < argc && interpretarMuestreo(argv[i + 1], muestreo)) {
+            ++i;
+        } else if (strcmp(argv[i], "--sin-cota") == 0) {
+            podarPorCota = false;
+        } else {
+            cerr << "Uso: " << argv[0] << " [--threads N] [--seed S] [--generaciones G] [--perfil ARCHIVO.csv|.json] [--traza ARCHIVO.json]"
+                 << " [--islas K] [--intervalo M] [--migrantes N] [--procesos P] [--direccion unix:RUTA|tcp:HOST:PUERTO]"
+                 << " [--lote ESCENARIOS.txt|.bin [--resultados ARCHIVO.csv] [--convertir ESCENARIOS.bin] [--representacion densa|dispersa]]"
+                 << " [--punto-control ARCHIVO [--cada N]] [--reanudar ARCHIVO]"
+                 << " [--estancamiento G] [--tiempo SEGUNDOS] [--meta VALOR] [--estadisticas ARCHIVO.csv]"
+                 << " [--seleccion uniforme|torneo|ranking|sus] [--torneo K] [--muestreo rechazo|constructivo] [--sin-cota]" << endl;
+            return 1;
+        }
+    }
+    if (representacion == REPRESENTACION_DISPERSA && archivoLote == nullptr) {
+        cerr << "--representacion dispersa solo esta disponible con --lote" << endl;
+        return 1;
+    }
+#ifdef _WIN32
+    if (numeroProcesos > 1 || identificadorTrabajador >= 0) {
+        cerr << "--procesos requiere sockets POSIX y no esta disponible en Windows" << endl;
+        return 1;
+    }
+#endif
+
+    // Instrumentacion por fases, solo disponible si se compilo con -DGA_INSTRUMENTACION
+    Instrumentacion& instrumentacion = Instrumentacion::global();
+    if ((archivoPerfil != nullptr || archivoTraza != nullptr) && !Instrumentacion::ACTIVA) {
+        cerr << "Aviso: --perfil y --traza requieren compilar con -DGA_INSTRUMENTACION" << endl;
+    }
+    if (archivoPerfil != nullptr && Instrumentacion::ACTIVA && !instrumentacion.abrirReporte(archivoPerfil)) {
+        cerr << "No se pudo abrir " << archivoPerfil << endl;
+        return 1;
+    }
+    if (archivoTraza != nullptr && Instrumentacion::ACTIVA && !instrumentacion.abrirTraza(archivoTraza)) {
+        cerr << "No se pudo abrir " << archivoTraza << endl;
+        return 1;
+    }
+
+    if (archivoLote != nullptr) {
+        // Modo lote: muchos escenarios en un solo proceso, repartidos entre los hilos del pool. El archivo puede
+        // ser la lista en texto o su forma binaria, que se proyecta en memoria y se lee escenario por escenario
+        bool binario = ArchivoEscenarios::esBinario(archivoLote);
+        ArchivoEscenarios archivo;
+        vector<Escenario> escenarios;
+        string error;
+        if (binario) {
+            if (!archivo.abrir(archivoLote, error)) {
+                cerr << error << endl;
+                return 1;
+            }
+        } else {
+            ifstream entrada(archivoLote);
+            if (!entrada) {
+                cerr << "No se pudo abrir " << archivoLote << endl;
+                return 1;
+            }
+            if (!leerEscenarios(entrada, escenarios, error)) {
+                cerr << archivoLote << ": " << error << endl;
+                return 1;
+            }
+        }
+
+        if (archivoBinario != nullptr) {
+            // Solo convertir la lista de texto a la forma binaria
+            if (binario) {
+                cerr << archivoLote << " ya esta en forma binaria" << endl;
+                return 1;
+            }
+            if (!ArchivoEscenarios::escribir(archivoBinario, escenarios, error)) {
+                cerr << error << endl;
+                return 1;
+            }
+            cerr << escenarios.size() << " escenarios escritos en " << archivoBinario << endl;
+            return 0;
+        }
+
+        PoolHilos poolHilos(numeroHilos);
+        LoteEscenarios lote(poolHilos);
+        lote.terminacion = terminacion;
+        lote.seleccion = seleccion;
+        lote.muestreo = muestreo;
+        lote.representacion = representacion;
+        lote.podarPorCota = podarPorCota;
+        vector<ResultadoEscenario> resultados;
+        chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+        if (binario) {
+            lote.correr(archivo, semilla, resultados);
+        } else {
+            lote.correr(escenarios, semilla, resultados);
+        }
+        double segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+
+        if (archivoResultados != nullptr) {
+            ofstream salida(archivoResultados);
+            LoteEscenarios::escribirResultados(salida, resultados);
+            if (!salida) {
+                cerr << "No se pudo escribir " << archivoResultados << endl;
+                return 1;
+            }
+        } else {
+            LoteEscenarios::escribirResultados(cout, resultados);
+        }
+        cerr << "Semilla del lote: " << semilla << endl;
+        cerr << "Lote: " << resultados.size() << " escenarios en " << segundos << " s con " << poolHilos.numeroHilos()
+             << " hilos (" << (segundos > 0 ? 3600.0 * resultados.size() / segundos : 0.0) << " escenarios/hora)" << endl;
+        return 0;
+    }
 
     // Variables específicas del problema
     int numeroCultivos = 5;                   // Número de cultivos
@@ -26,24 +222,189 @@ int main() {
 
     Cultivacion cultivacion(meses, numeroCultivos);
 
+    bool variasPoblaciones = numeroIslas > 1 || numeroProcesos > 1 || identificadorTrabajador >= 0;
+    if ((archivoReanudar != nullptr || archivoPuntoControl != nullptr) && variasPoblaciones) {
+        cerr << "--punto-control y --reanudar solo estan disponibles con una sola poblacion" << endl;
+        return 1;
+    }
+    // Los trabajadores no comparten sus estadisticas con el coordinador, que no puede decidir cuando parar
+    bool criteriosTerminacion = terminacion.generacionesSinMejora > 0 || terminacion.segundosMaximos > 0.0 ||
+                                terminacion.valorMeta < numeric_limits<double>::infinity() || archivoEstadisticas != nullptr;
+    if (criteriosTerminacion && (numeroProcesos > 1 || identificadorTrabajador >= 0)) {
+        cerr << "--estancamiento, --tiempo, --meta y --estadisticas no estan disponibles con --procesos" << endl;
+        return 1;
+    }
+
+#ifndef _WIN32
+    if (identificadorTrabajador >= 0 || numeroProcesos > 1) {
+        // Modelo de islas distribuido: el coordinador lanza los trabajadores, que se conectan a el por sockets
+        IslasDistribuidas distribuidas(numeroProcesos, numeroIslas, intervaloMigracion, numeroMigrantes);
+        distribuidas.seleccion = seleccion;
+        distribuidas.muestreo = muestreo;
+        distribuidas.podarPorCota = podarPorCota;
+        if (direccionCoordinador != nullptr && !distribuidas.direccion.interpretar(direccionCoordinador)) {
+            cerr << "Direccion no valida: " << direccionCoordinador << " (use unix:RUTA o tcp:HOST:PUERTO)" << endl;
+            return 1;
+        }
+        if (identificadorTrabajador >= 0) {
+            return distribuidas.trabajar(identificadorTrabajador, tamanoPoblacion, maximoGeneraciones,
+                                         numeroCultivos, meses, cultivacion, semilla);
+        }
+
+        cout << "Semilla: " << semilla << " (repetir la corrida con --seed " << semilla << ")" << endl;
+        Cromosoma mejorCromosoma;
+        if (!distribuidas.coordinar(argv[0], semilla, maximoGeneraciones, numeroCultivos * meses, mejorCromosoma)) return 1;
+        mejorCromosoma.imprimirDetallesCromosoma(numeroCultivos, meses,
+                                                 cultivacion.areaTotalDisponible,
+                                                 cultivacion.requerimientoAgua,
+                                                 cultivacion.mesesCultivo,
+                                                 cultivacion.maxCosechaPorArea);
+        cout << "Procesos: " << distribuidas.numeroProcesos << " con " << distribuidas.islasPorProceso
+             << " islas cada uno, migracion cada " << distribuidas.intervaloMigracion << " generaciones de "
+             << distribuidas.numeroMigrantes << " cromosomas (" << distribuidas.direccion.texto() << ")" << endl;
+        return 0;
+    }
+#endif
+
+    if (archivoReanudar == nullptr && archivoPuntoControl == nullptr) {
+        cout << "Semilla: " << semilla << " (repetir la corrida con --seed " << semilla << ")" << endl;
+    }
+
+    if (numeroIslas > 1) {
+        // Modelo de islas: cada isla evoluciona en su propio hilo y migra sus mejores cromosomas a la vecina
+        ModeloIslas modelo(numeroIslas, intervaloMigracion, numeroMigrantes);
+        modelo.muestreo = muestreo;
+        modelo.seleccion = seleccion;
+        modelo.podarPorCota = podarPorCota;
+        modelo.inicializar(tamanoPoblacion, numeroCultivos, meses, cultivacion, semilla);
+
+        // Los criterios de terminacion se consultan entre migraciones, con las islas detenidas
+        ofstream estadisticasSalida;
+        if (archivoEstadisticas != nullptr) {
+            estadisticasSalida.open(archivoEstadisticas);
+            if (!estadisticasSalida) {
+                cerr << "No se pudo abrir " << archivoEstadisticas << endl;
+                return 1;
+            }
+            EstadisticasGeneracion::escribirCabecera(estadisticasSalida);
+        }
+        EstadisticasGeneracion estadisticas;
+        terminacion.maximoGeneraciones = maximoGeneraciones;
+        terminacion.iniciar();
+        modelo.calcularEstadisticas(estadisticas, 0);
+        bool seguir = terminacion.continuar(estadisticas);
+        if (estadisticasSalida.is_open()) estadisticas.escribir(estadisticasSalida);
+        for (int generacion = 0; seguir;) {
+            int tramo = min(modelo.intervaloMigracion, maximoGeneraciones - generacion);
+            modelo.evolucionar(tramo, numeroCultivos, meses, cultivacion);
+            generacion += tramo;
+            instrumentacion.cerrarGeneracion(generacion);
+
+            modelo.calcularEstadisticas(estadisticas, generacion);
+            seguir = terminacion.continuar(estadisticas);
+            if (estadisticasSalida.is_open()) estadisticas.escribir(estadisticasSalida);
+        }
+
+        Cromosoma mejorCromosoma = modelo.mejorCromosoma();
+        mejorCromosoma.imprimirDetallesCromosoma(numeroCultivos, meses,
+                                                 cultivacion.areaTotalDisponible,
+                                                 cultivacion.requerimientoAgua,
+                                                 cultivacion.mesesCultivo,
+                                                 cultivacion.maxCosechaPorArea);
+        cout << "Terminacion: " << nombreMotivo(terminacion.motivo) << " tras " << estadisticas.generacion << " generaciones ("
+             << estadisticas.segundos << " s)" << endl;
+        cout << "Islas: " << modelo.numeroIslas << ", migracion cada " << modelo.intervaloMigracion << " generaciones de "
+             << modelo.numeroMigrantes << " cromosomas" << endl;
+        instrumentacion.finalizar();
+        return 0;
+    }
+
     // Inicializar la población y la estructura cultivoPlantado
     Generacion poblacion(tamanoPoblacion, dimension);
+    PoolHilos poolHilos(numeroHilos);
+    poblacion.poolHilos = &poolHilos;
+    poblacion.semilla = semilla;
+    poblacion.seleccion = seleccion;
+    poblacion.muestreo = muestreo;
+    poblacion.podarPorCota = podarPorCota;
 
-    poblacion.inicializarCromosomas(numeroCultivos, meses, cultivacion);
-    poblacion.inicializarValoresObjetivo(numeroCultivos, meses, cultivacion);
-
-    Cromosoma mejorCromosoma = poblacion.encontrarMejorCromosoma();
+    Cromosoma mejorCromosoma;
+    int primeraGeneracion = 0;
+    if (archivoReanudar != nullptr) {
+        // Continuar una corrida guardada: la poblacion, la semilla y la generacion salen del punto de control
+        int cultivosGuardados = 0, mesesGuardados = 0;
+        string error;
+        if (!PuntoControl::cargar(archivoReanudar, poblacion, mejorCromosoma, cultivosGuardados, mesesGuardados, error)) {
+            cerr << error << endl;
+            return 1;
+        }
+        if (cultivosGuardados != numeroCultivos || mesesGuardados != meses) {
+            cerr << archivoReanudar << " es de un problema de " << cultivosGuardados << " cultivos y " << mesesGuardados << " meses" << endl;
+            return 1;
+        }
+        // El punto de control no guarda los estados por mes: sin ellos no habria evaluacion incremental ni cota
+        // desde los padres en el resto de la corrida. Reevaluar los reconstruye; el nucleo es determinista y los
+        // valores no cambian
+        poblacion.inicializarValoresObjetivo(numeroCultivos, meses, cultivacion);
+        semilla = poblacion.semilla;
+        tamanoPoblacion = poblacion.tamanoPoblacion;
+        primeraGeneracion = static_cast<int>(poblacion.numeroGeneracion);
+        cerr << "Reanudando " << archivoReanudar << " en la generacion " << primeraGeneracion << endl;
+    }
+    if (archivoReanudar != nullptr || archivoPuntoControl != nullptr) {
+        cout << "Semilla: " << semilla << " (repetir la corrida con --seed " << semilla << ")" << endl;
+    }
+    if (archivoReanudar == nullptr) {
+        poblacion.inicializarCromosomas(numeroCultivos, meses, cultivacion);
+        poblacion.inicializarValoresObjetivo(numeroCultivos, meses, cultivacion);
+        instrumentacion.cerrarGeneracion(0);
+        mejorCromosoma = poblacion.encontrarMejorCromosoma();
+    }
     double mejorAptitud = mejorCromosoma.valorObjetivo;
 
-    // Bucle externo: iterar a través de las generaciones
-    for (int generacion = 0; generacion < maximoGeneraciones; ++generacion) {
+    // El punto de control se escribe en otro hilo mientras sigue la evolucion
+    unique_ptr<PuntoControl> puntoControl;
+    if (archivoPuntoControl != nullptr) puntoControl.reset(new PuntoControl(archivoPuntoControl));
+
+    // Estadisticas por generacion: el mejor se sigue por su indice y solo se copia cuando mejora
+    ofstream estadisticasSalida;
+    if (archivoEstadisticas != nullptr) {
+        estadisticasSalida.open(archivoEstadisticas);
+        if (!estadisticasSalida) {
+            cerr << "No se pudo abrir " << archivoEstadisticas << endl;
+            return 1;
+        }
+        EstadisticasGeneracion::escribirCabecera(estadisticasSalida);
+    }
+    EstadisticasGeneracion estadisticas;
+    terminacion.maximoGeneraciones = maximoGeneraciones;
+    terminacion.iniciar();
+    estadisticas.calcular(poblacion.poblacion, primeraGeneracion);
+    bool seguir = terminacion.continuar(estadisticas);
+    if (estadisticasSalida.is_open()) estadisticas.escribir(estadisticasSalida);
+
+    // Bucle externo: iterar a través de las generaciones hasta que se cumpla algun criterio de terminacion
+    while (seguir) {
         poblacion.obtenerNuevaGeneracion(tamanoPoblacion, numeroCultivos, meses, cultivacion);
-        poblacion.inicializarValoresObjetivo(numeroCultivos, meses, cultivacion);
+        int generacion = static_cast<int>(poblacion.numeroGeneracion);
+        instrumentacion.cerrarGeneracion(generacion);
 
-        if (poblacion.encontrarMejorCromosoma().valorObjetivo > mejorAptitud) {
-            mejorCromosoma = poblacion.encontrarMejorCromosoma();
+        estadisticas.calcular(poblacion.poblacion, generacion);
+        if (estadisticas.mejor > mejorAptitud) {
+            mejorCromosoma = poblacion.poblacion.extraer(estadisticas.indiceMejor);
             mejorAptitud = mejorCromosoma.valorObjetivo;
         }
+
+        if (puntoControl && generacion % generacionesPorPunto == 0 &&
+            !puntoControl->guardar(poblacion, mejorCromosoma, numeroCultivos, meses)) {
+            cerr << "Aviso: no se pudo escribir el punto de control " << archivoPuntoControl << endl;
+        }
+
+        seguir = terminacion.continuar(estadisticas);
+        if (estadisticasSalida.is_open()) estadisticas.escribir(estadisticasSalida);
+    }
+    if (puntoControl && !puntoControl->esperar()) {
+        cerr << "Aviso: no se pudo escribir el punto de control " << archivoPuntoControl << endl;
     }
 
     mejorCromosoma.imprimirDetallesCromosoma(numeroCultivos, meses,
@@ -51,5 +412,26 @@ int main() {
                                              cultivacion.requerimientoAgua,
                                              cultivacion.mesesCultivo,
                                              cultivacion.maxCosechaPorArea);
+    cout << "Terminacion: " << nombreMotivo(terminacion.motivo) << " tras " << estadisticas.generacion << " generaciones ("
+         << estadisticas.segundos << " s)" << endl;
+
+    // Consultas a la cache de aptitud: cada fallo es una evaluacion real de la funcion objetivo
+    uint64_t aciertos = poblacion.cacheAptitud.aciertos.load();
+    uint64_t fallos = poblacion.cacheAptitud.fallos.load();
+    cout << "Cache de aptitud: " << aciertos << " aciertos, " << fallos << " evaluaciones ("
+         << (aciertos + fallos > 0 ? 100.0 * aciertos / (aciertos + fallos) : 0.0) << "% evitadas)" << endl;
+
+    // Evaluacion incremental: meses que se reanudaron desde el estado de un padre en lugar de recalcularse
+    uint64_t mesesEvaluados = poblacion.mesesEvaluados;
+    uint64_t mesesOmitidos = poblacion.mesesOmitidos;
+    cout << "Evaluacion incremental: " << mesesEvaluados << " meses evaluados, " << mesesOmitidos << " reutilizados ("
+         << (mesesEvaluados + mesesOmitidos > 0 ? 100.0 * mesesOmitidos / (mesesEvaluados + mesesOmitidos) : 0.0) << "%)" << endl;
+
+    // Cota superior: hijos que no podian sobrevivir y se descartaron sin evaluarlos
+    uint64_t hijosAcotados = poblacion.hijosAcotados;
+    uint64_t hijosDescartados = poblacion.hijosDescartados;
+    cout << "Cota superior: " << hijosDescartados << " de " << hijosAcotados << " hijos descartados sin evaluar ("
+         << (hijosAcotados > 0 ? 100.0 * hijosDescartados / hijosAcotados : 0.0) << "%)" << endl;
+    instrumentacion.finalizar();
     return 0;
 }